@@ -42,10 +42,13 @@
 
 // This is the SOCD section.
 // SOCD stands for `simultaneous opposing cardinal directions`.
-// There are three options for `DEFAULT_SOCD_MODE` currently:
+// There are six options for `DEFAULT_SOCD_MODE` currently:
 // 1 - `SOCD_MODE_NEUTRAL` - This is a neutral SOCD.  EG. when you press `up` + `down` no input will be registered.
 // 2 - `SOCD_MODE_UP_PRIORITY` - This is up priority SOCD.  EG. when you press `up` + `down` `up` will be registered.
 // 3 - `SOCD_MODE_SECOND_INPUT_PRIORITY` - This is last priority SOCD.  EG. when you press and hold `up` then press `down` `down` will be registered.
+// 4 - `SOCD_MODE_FIRST_INPUT_PRIORITY` - This is first priority SOCD.  EG. when you press and hold `up` then press `down` `up` will be registered.
+// 5 - `SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL` - Up priority on `up` + `down`, last priority on `left` + `right`.
+// 6 - `SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL` - Last priority on `up` + `down`, neutral on `left` + `right`.
 
 #define DEFAULT_SOCD_MODE SOCD_MODE_NEUTRAL
 
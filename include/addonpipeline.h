@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _ADDONPIPELINE_H_
+#define _ADDONPIPELINE_H_
+
+#include <stdint.h>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "BoardConfig.h"
+#include "gpaddon.h"
+#include "bootstats.h"
+#include "perfstats.h"
+
+// Run the input addons from a compile-time list instead of the Storage::Inputs vector
+#ifndef GAMEPAD_STATIC_ADDONS
+#define GAMEPAD_STATIC_ADDONS 1
+#endif
+
+// Addons stored by value in a tuple and called on their concrete type, so the loop has no virtual dispatch.
+// available() is resolved once in setup(), each loop only tests a bit.
+template <typename... Addons>
+class AddonPipeline
+{
+public:
+	static_assert(sizeof...(Addons) <= 32, "AddonPipeline supports up to 32 addons");
+
+	AddonPipeline() : enabled(0) {}
+
+	// Set up the available addons, and list them in the registry for lookups by name()
+	void setup(std::vector<GPAddon*> &registry)
+	{
+		setupAll(registry, std::index_sequence_for<Addons...>{});
+	}
+
+	inline void __attribute__((always_inline)) process(const FrameContext &frame)
+	{
+		processAll(frame, std::index_sequence_for<Addons...>{});
+	}
+
+	inline bool dirty()
+	{
+		return dirtyAll(std::index_sequence_for<Addons...>{});
+	}
+
+	template <size_t I>
+	inline typename std::tuple_element<I, std::tuple<Addons...>>::type & get() { return std::get<I>(addons); }
+
+	inline bool isEnabled(size_t index) { return enabled & (1 << index); }
+
+private:
+	template <size_t... I>
+	void setupAll(std::vector<GPAddon*> &registry, std::index_sequence<I...>)
+	{
+		int expand[] = { 0, (setupOne<I>(registry), 0)... };
+		(void)expand;
+	}
+
+	template <size_t I>
+	void setupOne(std::vector<GPAddon*> &registry)
+	{
+		auto &addon = std::get<I>(addons);
+		if (!addon.available())
+			return;
+
+		uint32_t start = time_us_32();
+		addon.setup();
+		BootStats::getInstance().addonSetup(addon.name(), time_us_32() - start);
+		registry.push_back(&addon);
+		enabled |= (1 << I);
+	#if GAMEPAD_PERF_STATS
+		perfStages[I] = PerfStats::getInstance().addStage(addon.name());
+	#endif
+	}
+
+	template <size_t... I>
+	inline void __attribute__((always_inline)) processAll(const FrameContext &frame, std::index_sequence<I...>)
+	{
+		int expand[] = { 0, ((enabled & (1 << I)) ? (std::get<I>(addons).process(frame), perfEnd<I>(), 0) : 0)... };
+		(void)expand;
+	}
+
+	template <size_t... I>
+	inline bool dirtyAll(std::index_sequence<I...>)
+	{
+		bool dirty = false;
+		int expand[] = { 0, (dirty = dirty || ((enabled & (1 << I)) && std::get<I>(addons).dirty()), 0)... };
+		(void)expand;
+		return dirty;
+	}
+
+	template <size_t I>
+	inline void __attribute__((always_inline)) perfEnd()
+	{
+		PERF_END(perfStages[I]);
+	}
+
+	std::tuple<Addons...> addons;
+	uint32_t enabled; // Bit per addon, available() at setup
+#if GAMEPAD_PERF_STATS
+	uint8_t perfStages[sizeof...(Addons)];
+#endif
+};
+
+#endif
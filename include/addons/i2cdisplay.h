@@ -53,6 +53,11 @@
 #define DISPLAY_USEWIRE 1
 #endif
 
+// 8-pixel pages sent per scheduler pass, each one blocks core1 for ~2ms at 800kHz, ~4ms at 400kHz
+#ifndef DISPLAY_PAGES_PER_PASS
+#define DISPLAY_PAGES_PER_PASS 1
+#endif
+
 // i2c Display Module
 #define I2CDisplayName "I2CDisplay"
 
@@ -64,6 +69,7 @@ public:
 	virtual void setup();
 	virtual void process();
 	virtual std::string name() { return I2CDisplayName; }
+	virtual AddonSchedule schedule() { return { 2500 * DISPLAY_PAGES_PER_PASS, 2, 4000 * DISPLAY_PAGES_PER_PASS }; } // A 128x64 frame every ~20ms
 	void clearScreen(int render); // DisplayModule
 	void drawStickless(int startX, int startY, int buttonRadius, int buttonPadding, Gamepad*);
 	void drawWasdBox(int startX, int startY, int buttonRadius, int buttonPadding, Gamepad*);
@@ -89,9 +95,14 @@ public:
 	void drawSplashScreen(int splashMode, int splashSpeed);
 	void drawDancepadA(int startX, int startY, int buttonSize, int buttonPadding, Gamepad*);
 	void drawDancepadB(int startX, int startY, int buttonSize, int buttonPadding, Gamepad*);
+	void drawScreen(bool configMode, bool splash);
 	uint8_t ucBackBuffer[1024];
 	OBDISP obd;
 	std::string statusBar;
+	uint32_t drawnVersion; // Storage snapshot version on screen
+	bool drawnGamepad;     // Screen shows the gamepad, not the splash or config mode
+	uint8_t dumpPage;      // Next 8-pixel page to send
+	uint8_t dirtyPages;    // Pages left to send since the last redraw
 };
 
 #endif
@@ -147,7 +147,6 @@
 #endif
 
 void configureAnimations(AnimationStation *as);
-AnimationHotkey animationHotkeys(Gamepad *gamepad);
 PixelMatrix createLedButtonLayout(ButtonLayout layout, int ledsPerPixel);
 PixelMatrix createLedButtonLayout(ButtonLayout layout, std::vector<uint8_t> *positions);
 
@@ -169,6 +168,8 @@ public:
 	virtual void setup();
 	virtual void process();
 	virtual std::string name() { return NeoPicoLEDName; }
+	virtual void handleEvent(const GamepadEvent &event);
+	virtual AddonSchedule schedule() { return { intervalMS * 1000, 0, 4000 }; } // LED frames come first
 	void configureLEDs();
 	uint32_t frame[100];
 private:
@@ -178,8 +179,7 @@ private:
 	std::vector<std::vector<Pixel>> generatedLEDWasd(std::vector<std::vector<uint8_t>> *positions);
 	std::vector<std::vector<Pixel>> createLEDLayout(ButtonLayout layout, uint8_t ledsPerPixel, uint8_t ledButtonCount);
 	uint8_t setupButtonPositions();
-	const uint32_t intervalMS = 10;
-	absolute_time_t nextRunTime;
+	const uint32_t intervalMS = 10; // Frame period, paced by the scheduler
 	uint8_t ledCount;
 	PixelMatrix matrix;
 	NeoPico *neopico;
@@ -188,6 +188,8 @@ private:
 	NeoPicoPlayerLEDs * neoPLEDs = nullptr;
 	AnimationStation as;
 	std::map<std::string, int> buttonPositions;
+	uint8_t featureData[EVENT_DATA_SIZE]; // Last USB OUT report
+	AnimationHotkey hotkeyAction;         // From EVENT_HOTKEY, applied on the next frame
 };
 
 #endif
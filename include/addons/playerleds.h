@@ -35,12 +35,15 @@ public:
 	virtual void setup();
 	virtual void process();
 	virtual std::string name() { return PLEDName; }
+	virtual void handleEvent(const GamepadEvent &event);
+	virtual AddonSchedule schedule() { return { 1000, 1, 500 }; }
 	PlayerLEDAddon() : type(PLED_TYPE) { }
 	PlayerLEDAddon(PLEDType type) : type(type) { }
 protected:
 	PLEDType type;
 	PWMPlayerLEDs * pwmLEDs = nullptr;
 	PLEDAnimationState animationState;
+	uint8_t featureData[EVENT_DATA_SIZE]; // Last USB OUT report
 };
 
 #endif
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _BOOTSTATS_H_
+#define _BOOTSTATS_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "BoardConfig.h"
+
+// Bring up gamepad GPIO and USB first, and set up input addons after the first report is out
+#ifndef GAMEPAD_FAST_BOOT
+#define GAMEPAD_FAST_BOOT 0
+#endif
+
+#define BOOT_MAX_ADDONS 8 // Addon setup timings kept per core
+#define BOOT_ADDON_NAME_SIZE 16
+#define BOOT_STATS_MAGIC 0x54534247 // "GBST", little-endian
+
+enum BootStage
+{
+	BOOT_STAGE_MAIN,         // main() entered, bootrom and runtime init before this
+	BOOT_STAGE_STORAGE,      // EEPROM copied to RAM and options checked
+	BOOT_STAGE_GAMEPAD,      // Gamepad pins set up and boot combos read
+	BOOT_STAGE_USB_INIT,     // initialize_driver() done
+	BOOT_STAGE_INPUTS,       // Input addons set up
+	BOOT_STAGE_USB_MOUNTED,  // Host configured the device
+	BOOT_STAGE_FIRST_REPORT, // First report accepted by the endpoint
+	BOOT_STAGE_AUX_START,    // core1 entered
+	BOOT_STAGE_AUX_READY,    // core1 addons set up
+	BOOT_STAGE_COUNT,
+};
+
+struct BootAddonTime
+{
+	char name[BOOT_ADDON_NAME_SIZE]; // Cut short if longer, always terminated
+	uint32_t micros;
+};
+
+// Everything timed during one boot, plain data so it can live in RAM the runtime doesn't clear
+struct BootRecord
+{
+	volatile uint32_t stages[BOOT_STAGE_COUNT];
+	BootAddonTime addons[2][BOOT_MAX_ADDONS];
+	volatile uint8_t addonCount[2];
+	bool fastBoot;
+};
+
+struct BootStatsStore
+{
+	uint32_t magic;   // BOOT_STATS_MAGIC once a gamepad-mode boot has been recorded
+	BootRecord last;
+};
+
+// Timestamps (us since power-on) of each boot stage. Each stage and core only has one writer.
+// A gamepad-mode boot is recorded into RAM that isn't zeroed at startup, so it survives the warm reboot
+// into web config mode, where /api/getBootStats serves it. Config-mode boots don't replace it.
+class BootStats {
+public:
+	BootStats(BootStats const&) = delete;
+	void operator=(BootStats const&)  = delete;
+	static BootStats& getInstance()
+	{
+		static BootStats instance;
+		return instance;
+	}
+
+	void setup(bool gamepadMode); // Once the boot mode is known, before core1 starts
+	void mark(BootStage stage);   // First call per stage wins
+	void addonSetup(const std::string &name, uint32_t micros);
+
+	static const char * stageName(BootStage stage);
+	const BootRecord * lastGamepadBoot(); // nullptr if there's none since power-on
+	inline const BootRecord & currentBoot() { return *record; }
+
+private:
+	BootStats();
+	BootRecord current;
+	BootRecord *record; // current until setup(true), then the kept one
+	BootStatsStore &store;
+};
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _DEBOUNCER_H_
+#define _DEBOUNCER_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+#include "enums.h"
+#include "gpiosampler.h"
+#include "hardware/platform_defs.h"
+
+#ifndef GAMEPAD_DEBOUNCE_MODE
+#define GAMEPAD_DEBOUNCE_MODE DEBOUNCE_MODE_EAGER
+#endif
+
+// Default window for every button, each can be changed in the web configurator
+#ifndef GAMEPAD_DEBOUNCE_MICROS
+#define GAMEPAD_DEBOUNCE_MICROS 5000
+#endif
+
+// Per-pin debouncer working on the whole (inverted, masked) GPIO word.
+// Only pins whose raw or debounced level differ are visited each call.
+class Debouncer
+{
+public:
+	Debouncer();
+
+	void setMode(DebounceMode mode);
+	void setWindow(uint8_t pin, uint32_t micros);
+	inline void setPinMask(uint32_t mask) { pinMask = mask; }
+
+	// changeMicros: optional per-pin time of the last raw edge (edge IRQ), more exact than the poll time
+	uint32_t process(uint32_t raw, uint32_t nowMicros, const uint32_t *changeMicros = nullptr);
+	// A pin is still waiting out its window
+	inline bool pending()
+	{
+		if (mode == DEBOUNCE_MODE_VERTICAL)
+			return (GpioSampler::getInstance().getState() & pinMask) != debounced;
+		return lastRaw != debounced;
+	}
+
+	// Time a pin's debounced level last changed (SOCD press order)
+	inline uint32_t changedMicros(uint8_t pin) { return pin < NUM_BANK0_GPIOS ? acceptedAt[pin] : 0; }
+
+	uint32_t debounced;
+	uint32_t pressed;      // Pins the last process() let a press through on
+	uint32_t pressMicros;  // Raw edge time of the oldest of them
+
+private:
+	inline void notePress(uint8_t pin, uint32_t edgeMicros)
+	{
+		if (!pressed || (int32_t)(edgeMicros - pressMicros) < 0)
+			pressMicros = edgeMicros;
+		pressed |= (1 << pin);
+	}
+
+	DebounceMode mode;
+	uint32_t pinMask;       // Pins taken from GpioSampler in vertical mode
+	uint32_t lastRaw;
+	uint32_t rawChangedAt[NUM_BANK0_GPIOS]; // Last raw edge seen by polling
+	uint32_t acceptedAt[NUM_BANK0_GPIOS];   // Last debounced edge
+	uint32_t windows[NUM_BANK0_GPIOS];
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _EDGECAPTURE_H_
+#define _EDGECAPTURE_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+
+// Capture input edges with GPIO interrupts and let the idle loop sleep between them
+#ifndef GAMEPAD_EDGE_IRQ
+#define GAMEPAD_EDGE_IRQ 0
+#endif
+
+#define EDGE_QUEUE_SIZE 256 // Must be a power of 2
+
+struct GpioEdge
+{
+	uint8_t pin;
+	bool pressed;    // Pin level right after the edge (pullups, so low = pressed)
+	uint32_t micros; // time_us_32() when the interrupt fired
+};
+
+// Single-producer (GPIO IRQ) / single-consumer (input loop) edge queue. GPIO interrupt enables are per core,
+// so the IRQ is armed on whichever core calls setup() first and stays there, even when the input loop runs on
+// core1 and rebuilds its mappings from there.
+class EdgeCapture {
+public:
+	EdgeCapture(EdgeCapture const&) = delete;
+	void operator=(EdgeCapture const&)  = delete;
+	static EdgeCapture& getInstance()
+	{
+		static EdgeCapture instance;
+		return instance;
+	}
+
+	void setup(uint32_t pinMask);  // (Re)arm edge interrupts for these pins, from either core
+	void push(const GpioEdge &edge); // IRQ context only
+	bool pop(GpioEdge &edge);
+	inline bool empty() { return head == tail; }
+	uint32_t overflows;            // Edges dropped because the queue was full
+
+private:
+	EdgeCapture() : overflows(0), head(0), tail(0), pinMask(0), irqCore(-1) {}
+	GpioEdge queue[EDGE_QUEUE_SIZE];
+	volatile uint32_t head; // Only written by the IRQ
+	volatile uint32_t tail; // Only written by the loop
+	volatile uint32_t pinMask; // The IRQ drops anything else, an edge can latch just before its pin is disarmed
+	int irqCore;
+};
+
+#endif
@@ -35,6 +35,15 @@ typedef enum
     NOSPLASH,
 } SplashMode;
 
+typedef enum
+{
+	DEBOUNCE_MODE_DISABLED,
+	DEBOUNCE_MODE_EAGER,     // Press registers at once, release waits out the window
+	DEBOUNCE_MODE_SYMMETRIC, // Both edges wait out the window
+	DEBOUNCE_MODE_VERTICAL,  // GpioSampler output, the window is set by the sample clock
+	DEBOUNCE_MODE_COUNT,
+} DebounceMode;
+
 typedef enum
 {
 	CONFIG_TYPE_WEB = 0,
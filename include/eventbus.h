@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _EVENTBUS_H_
+#define _EVENTBUS_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hotkeys.h"
+
+#define EVENT_QUEUE_SIZE      32 // Must be a power of 2
+#define EVENT_MAX_SUBSCRIBERS 4  // Per event type
+#define EVENT_DATA_SIZE       32
+
+class GPAddon;
+
+typedef enum
+{
+	EVENT_INPUT,             // Processed buttons/d-pad changed
+	EVENT_HOTKEY,            // Hotkey fired (HotkeyAction)
+	EVENT_USB_OUT_REPORT,    // Host sent new output report data (X-Input LEDs/rumble)
+	EVENT_LED_OPTIONS,       // LED options were saved, addons reconfigure
+	EVENT_TYPE_COUNT,
+} EventType;
+
+struct InputEvent
+{
+	uint16_t buttons;
+	uint16_t pressed;
+	uint16_t released;
+	uint8_t dpad;
+	uint8_t dpadPressed;
+	uint8_t dpadReleased;
+};
+
+struct GamepadEvent
+{
+	uint8_t type;    // EventType
+	uint32_t micros; // time_us_32() when published
+	union
+	{
+		InputEvent input;
+		HotkeyAction hotkey;
+		uint8_t data[EVENT_DATA_SIZE];
+	};
+};
+
+struct EventQueue
+{
+	GamepadEvent entries[EVENT_QUEUE_SIZE];
+	volatile uint32_t head; // Only written by the producer core
+	volatile uint32_t tail; // Only written by the addon core
+};
+
+// Either core publishes, the core running the addons dispatches to subscribers. Each core has its own
+// single-producer/single-consumer ring in RAM, so there's no lock; the SIO FIFO is left alone because
+// multicore_lockout (flash writes) owns it.
+class EventBus {
+public:
+	EventBus(EventBus const&) = delete;
+	void operator=(EventBus const&)  = delete;
+	static EventBus& getInstance()
+	{
+		static EventBus instance;
+		return instance;
+	}
+
+	bool subscribe(EventType type, GPAddon *addon); // Addon core, during setup
+	bool publish(const GamepadEvent &event);        // Either core, wakes the other from __wfe
+	uint32_t dispatch();                            // Addon core only, returns the events handled
+	inline bool empty() { return queues[0].head == queues[0].tail && queues[1].head == queues[1].tail; }
+	uint32_t overflows;                             // Events dropped because the addon core fell behind
+
+private:
+	EventBus() : overflows(0), queues{} { memset(subscriberCount, 0, sizeof(subscriberCount)); }
+	uint32_t dispatch(EventQueue &queue);
+	EventQueue queues[2]; // Per producer core
+	GPAddon *subscribers[EVENT_TYPE_COUNT][EVENT_MAX_SUBSCRIBERS];
+	uint8_t subscriberCount[EVENT_TYPE_COUNT];
+};
+
+#endif
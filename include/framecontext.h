@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _FRAMECONTEXT_H_
+#define _FRAMECONTEXT_H_
+
+#include "gamepad.h"
+
+struct BoardOptions;
+
+// Per-frame data shared by every input addon, built once per input loop
+struct FrameContext
+{
+	FrameContext(Gamepad *gamepad, const GamepadState &previous, const BoardOptions &boardOptions, uint64_t micros, uint32_t hotkeys)
+		: gamepad(gamepad),
+		  current(gamepad->state),
+		  previous(previous),
+		  boardOptions(boardOptions),
+		  micros(micros),
+		  millis(micros / 1000),
+		  hotkeys(hotkeys),
+		  pressedPins(gamepad->debouncer.pressed),
+		  pressMicros(gamepad->debouncer.pressMicros),
+		  held(current.buttons),
+		  pressed(current.buttons & ~previous.buttons),
+		  released(previous.buttons & ~current.buttons),
+		  dpadHeld(current.dpad),
+		  dpadPressed(current.dpad & ~previous.dpad),
+		  dpadReleased(previous.dpad & ~current.dpad) {}
+
+	Gamepad *gamepad;                  // Gamepad being built, addons modify its state
+	const GamepadState current;        // MPGS-processed state, before any addon ran
+	const GamepadState &previous;      // Same, from the last frame the pipeline ran
+	const BoardOptions &boardOptions;
+	const uint64_t micros;             // Loop timestamp, the same for every addon this frame
+	const uint32_t millis;
+	const uint32_t hotkeys;            // Bit per HotkeyActionType fired this frame
+	const uint32_t pressedPins;        // Pins debounced to pressed this frame
+	const uint32_t pressMicros;        // Raw edge time of the oldest of them (press to report latency)
+
+	const uint16_t held;               // Button masks
+	const uint16_t pressed;
+	const uint16_t released;
+	const uint8_t dpadHeld;            // D-pad masks
+	const uint8_t dpadPressed;
+	const uint8_t dpadReleased;
+};
+
+#endif
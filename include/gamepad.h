@@ -6,15 +6,31 @@
 #include <MPGS.h>
 #include "pico/stdlib.h"
 
+#include "debouncer.h"
+#include "socd.h"
+#include "hotkeys.h"
+
 // MUST BE DEFINED FOR MPG
 extern uint32_t getMillis();
 extern uint64_t getMicro();
 
 #define GAMEPAD_POLL_MS 1
-#define GAMEPAD_POLL_MICRO 100
+#define GAMEPAD_POLL_MICRO 100 // Input loop period per 1ms of USB poll interval
+
+// USB poll interval (endpoint bInterval) in ms, 0 keeps each input mode's descriptor default
+#ifndef GAMEPAD_POLL_INTERVAL
+#define GAMEPAD_POLL_INTERVAL 0
+#endif
 
 #define GAMEPAD_FEATURE_REPORT_SIZE 32
 
+// GPIO word to state lookup: one 256 entry table per byte, each entry packs buttons | dpad | aux
+#define GAMEPAD_LUT_COUNT      4
+#define GAMEPAD_LUT_DPAD_SHIFT 16
+#define GAMEPAD_LUT_AUX_SHIFT  20
+
+#include "staticpins.h"
+
 struct GamepadButtonMapping
 {
 	GamepadButtonMapping(uint8_t p, uint16_t bm) : pin(p), pinMask((1 << p)), buttonMask(bm) {}
@@ -39,6 +55,39 @@ public:
 	void setup();
 	void process();
 	void read();
+	void debounce(); // Replaces the MPGS debouncer
+	void updateMappings();
+	void setRemapProfile(uint8_t profile); // RAM only, nothing is saved
+	void processHotkeys(uint32_t nowMicros); // Replaces MPGS hotkey(), fired actions wait in hotkeys.pop()
+
+	// Convert an inverted GPIO word to dpad/buttons/aux, branch free
+	inline void __attribute__((always_inline)) translate(uint32_t values)
+	{
+		uint32_t output;
+	#if GAMEPAD_STATIC_PINS
+		if (staticPins)
+			output = lutInvertYAxis ? staticTranslate<true>(values) : staticTranslate<false>(values);
+		else
+	#endif
+		output = pinLUT[0][values & 0xFF]
+			| pinLUT[1][(values >> 8) & 0xFF]
+			| pinLUT[2][(values >> 16) & 0xFF]
+			| pinLUT[3][(values >> 24) & 0xFF];
+
+		state.buttons = output & 0xFFFF;
+		state.dpad = (output >> GAMEPAD_LUT_DPAD_SHIFT) & GAMEPAD_MASK_DPAD;
+		#ifdef PIN_SETTINGS
+		state.aux = output >> GAMEPAD_LUT_AUX_SHIFT;
+		#endif
+	}
+
+	inline bool debouncing() { return debouncer.pending(); }
+
+	// Inverted GPIO levels of the pins this gamepad reads (change detection)
+	inline uint32_t __attribute__((always_inline)) sampleGpio()
+	{
+		return ~gpio_get_all() & inputMask;
+	}
 
 	inline bool __attribute__((always_inline)) pressedF1()
 	{
@@ -68,6 +117,17 @@ public:
 	GamepadButtonMapping *mapButtonA1;
 	GamepadButtonMapping *mapButtonA2;
 	GamepadButtonMapping **gamepadMappings;
+	uint32_t inputMask;
+	uint32_t rawGpio;         // Inverted, masked GPIO word from the last read()
+	Debouncer debouncer;
+	uint32_t (*pinLUT)[256];  // GAMEPAD_LUT_COUNT tables, rebuilt by updateMappings()
+	bool lutInvertYAxis;      // options.invertYAxis the tables were built with
+	bool staticPins;          // Mapping matches BoardConfig.h, translate() uses the folded GAMEPAD_STATIC_PINS path
+	uint32_t edgeMicros[NUM_BANK0_GPIOS]; // Time of each pin's last edge (GAMEPAD_EDGE_IRQ or GAMEPAD_PIO_SAMPLER)
+	SOCDCleaner socdCleaner;
+	uint8_t dpadPins[4];      // Pin behind each output direction (Up, Down, Left, Right), after remap and Y-axis inversion
+	uint8_t remapProfile;     // BoardOptions::remapProfiles entry folded into the tables
+	HotkeyEngine hotkeys;
 };
 
 #endif
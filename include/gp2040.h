@@ -9,6 +9,44 @@
 // GP2040 Classes
 #include "gamepad.h"
 #include "gpaddon.h"
+#include "addonpipeline.h"
+
+#include "inputs/analog.h" // Inputs
+#include "inputs/jslider.h"
+#include "inputs/turbo.h"
+#include "inputs/macro.h"
+
+// Run the input loop just ahead of the host's IN token (learned from USB SOF) instead of on a free-running timer
+#ifndef GAMEPAD_SOF_SYNC
+#define GAMEPAD_SOF_SYNC 0
+#endif
+
+// Slack (us) left between finishing a report and the expected IN token
+#ifndef GAMEPAD_SOF_MARGIN_MICRO
+#define GAMEPAD_SOF_MARGIN_MICRO 20
+#endif
+
+#define CORE_LAYOUT_SHARED     0 // Core0 runs the input loop and USB, core1 the aux addons
+#define CORE_LAYOUT_INPUT_CORE 1 // Core1 only samples and processes inputs, core0 runs USB and the aux addons
+
+// Which core runs what, outside of config mode
+#ifndef GAMEPAD_CORE_LAYOUT
+#define GAMEPAD_CORE_LAYOUT CORE_LAYOUT_SHARED
+#endif
+
+// Input loop period (us) on the input core with CORE_LAYOUT_INPUT_CORE
+#ifndef GAMEPAD_INPUT_CORE_MICRO
+#define GAMEPAD_INPUT_CORE_MICRO 50
+#endif
+
+#define INPUT_MODE_PENDING_NONE 0xFF
+
+#define CONFIG_MODE_SCRATCH 0          // Watchdog scratch register asking the next boot for config mode
+#define CONFIG_MODE_MAGIC   0x47504346 // "FCPG"
+
+#if GAMEPAD_STATIC_ADDONS
+typedef AddonPipeline<AnalogInput, JSliderInput, TurboInput, MacroInput> InputAddons;
+#endif
 
 class GP2040 {
 public:
@@ -16,10 +54,30 @@ public:
     ~GP2040();
     void setup();           // setup core0
     void run();             // loop core0
+    void runInputCore();    // loop core1 with CORE_LAYOUT_INPUT_CORE
+    bool inputCoreLayout(); // CORE_LAYOUT_INPUT_CORE is in effect (never in config mode)
 private:
+    void runUsb();
+    void setupInputs();
     void setupInput(GPAddon*);
+    void bootProgress();
+    void processInputs(Gamepad*, uint64_t now);
+    bool inputsDirty(Gamepad*, uint64_t now);
+    void handleHotkey(Gamepad*, const HotkeyAction &);
+    void switchInputMode(Gamepad*, InputMode);
     uint64_t nextRuntime;
-    Gamepad snapshot;
+    uint32_t pollMicros;     // Free-running loop period, scaled to the USB poll interval
+    bool inputsReady;        // Input addons set up (deferred until the first report with GAMEPAD_FAST_BOOT)
+    bool booted;             // First report is out
+    uint32_t pipelineMicros; // Recent worst-case read to send_report time (SOF lead)
+    uint32_t lastGpioValues; // GPIO word the pipeline last ran on
+    bool reportPending;      // Last report didn't make it to the endpoint
+    volatile uint8_t pendingInputMode; // Input mode hotkey waiting for the USB core (CORE_LAYOUT_INPUT_CORE)
+    GamepadState lastState;  // MPGS-processed state of the last frame (addon edge masks)
+#if GAMEPAD_STATIC_ADDONS
+    InputAddons inputAddons;
+#endif
+    Gamepad snapshot;        // Report built from the published state with CORE_LAYOUT_INPUT_CORE
 };
 
 #endif
@@ -8,9 +8,7 @@
 
 #include <vector>
 
-#include "addons/i2cdisplay.h"
-#include "addons/neopicoleds.h"
-#include "addons/playerleds.h"
+#include "gpaddon.h"
 
 class GP2040Aux {
 public:
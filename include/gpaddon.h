@@ -2,6 +2,9 @@
 #define _GPAddon_H_
 
 #include "gamepad.h"
+#include "framecontext.h"
+#include "eventbus.h"
+#include "scheduler.h"
 
 #include <string>
 
@@ -10,8 +13,12 @@ class GPAddon
 public:
 	virtual bool available() = 0;
 	virtual void setup() = 0;
-	virtual void process() = 0;
+	virtual void process() {}
+	virtual void process(const FrameContext &) { process(); } // Input addons, once per input loop frame
 	virtual std::string name() = 0;
+	virtual bool dirty() { return true; } // Needs process() this frame even if no gamepad input changed
+	virtual void handleEvent(const GamepadEvent &) {} // Core1 addons, events subscribed to with EventBus
+	virtual AddonSchedule schedule() { return { 0, 255, 0 }; } // Core1 addons: every pass, after everything else
 private:
 };
 
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _GPIOSAMPLER_H_
+#define _GPIOSAMPLER_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+#include "hardware/platform_defs.h"
+
+// Sample clock of the vertical counter debouncer
+#ifndef GAMEPAD_SAMPLE_HZ
+#define GAMEPAD_SAMPLE_HZ 10000
+#endif
+
+// Counter width, a pin has to read differently for 2^bits samples in a row to flip (16 samples = 1.6ms at 10kHz)
+#ifndef GAMEPAD_SAMPLE_COUNTER_BITS
+#define GAMEPAD_SAMPLE_COUNTER_BITS 4
+#endif
+
+#define GPIO_SAMPLER_PIN_MASK ((1u << NUM_BANK0_GPIOS) - 1)
+
+// Debounces every bank0 GPIO at once from a hardware alarm interrupt, using one
+// counter bit-plane per counter bit (a "vertical" counter) so each sample is a handful of bitwise ops.
+// Only DEBOUNCE_MODE_VERTICAL runs it. The alarm fires every sample period while it does, so
+// neither core's sleepUntil() stays asleep longer than one period and idle power doesn't drop.
+class GpioSampler {
+public:
+	GpioSampler(GpioSampler const&) = delete;
+	void operator=(GpioSampler const&)  = delete;
+	static GpioSampler& getInstance()
+	{
+		static GpioSampler instance;
+		return instance;
+	}
+
+	void start(); // Start the sample clock, claims an alarm on the calling core
+	void stop();  // Stop it and give the alarm back, state is stale until the next start()
+	void sample(); // Alarm IRQ context only
+
+	// Debounced and inverted (pullups, 1 = pressed) level of every bank0 GPIO
+	inline uint32_t getState() { return state; }
+	inline bool pressed(uint8_t pin) { return state & (1u << pin); }
+	inline bool running() { return alarm >= 0; }
+
+	uint32_t nextSample; // Alarm target of the next sample
+	uint32_t periodMicros;
+
+private:
+	GpioSampler() : nextSample(0), periodMicros(0), state(0), alarm(-1) {}
+	volatile uint32_t state;
+	uint32_t counter[GAMEPAD_SAMPLE_COUNTER_BITS]; // Bit-plane k holds bit k of every pin's counter
+	int alarm;
+};
+
+#endif
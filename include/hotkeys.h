@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _HOTKEYS_H_
+#define _HOTKEYS_H_
+
+#include <stdint.h>
+
+#define HOTKEY_MAX_ENTRIES 32 // One bit each in the active mask
+#define HOTKEY_QUEUE_SIZE  8  // Must be a power of 2
+
+struct GamepadButtonMapping;
+
+typedef enum
+{
+	HOTKEY_ACTION_NONE,
+	HOTKEY_ACTION_HOME_BUTTON,   // Sends A1 while held
+	HOTKEY_ACTION_DPAD_MODE,     // param: DpadMode
+	HOTKEY_ACTION_SOCD_MODE,     // param: SOCDMode
+	HOTKEY_ACTION_INVERT_Y_AXIS,
+	HOTKEY_ACTION_INPUT_MODE,    // param: InputMode, re-enumerates USB
+	HOTKEY_ACTION_REMAP_PROFILE, // param: BoardOptions::remapProfiles index
+	HOTKEY_ACTION_LEDS,          // param: AnimationHotkey
+	HOTKEY_ACTION_MACRO_RECORD,  // Starts or stops recording
+	HOTKEY_ACTION_MACRO_PLAY,    // Starts or stops playback
+	HOTKEY_ACTION_CONFIG_MODE,   // Reboots into web config mode
+} HotkeyActionType;
+
+typedef enum
+{
+	HOTKEY_TRIGGER_PRESS, // Once, when the chord completes
+	HOTKEY_TRIGGER_HOLD,  // Once, after the chord has been held for holdMillis
+	HOTKEY_TRIGGER_TAP,   // Once, when the chord is let go within holdMillis
+} HotkeyTrigger;
+
+typedef enum
+{
+	HOTKEY_MODIFIER_F1, // S1 + S2, or PIN_SETTINGS
+	HOTKEY_MODIFIER_F2, // S2 + A1
+} HotkeyModifier;
+
+struct HotkeyAction
+{
+	uint8_t type;  // HotkeyActionType
+	uint8_t param;
+};
+
+// A chord as the user sees it, in buttons
+struct HotkeyBinding
+{
+	uint8_t modifier;    // HotkeyModifier
+	uint16_t buttons;    // GAMEPAD_MASK_* on top of the modifier
+	uint8_t dpad;
+	uint8_t trigger;     // HotkeyTrigger
+	uint16_t holdMillis;
+	HotkeyAction action;
+};
+
+// The same chord in GPIO pins, as matched every frame
+struct HotkeyEntry
+{
+	uint32_t chordPins;
+	uint32_t holdMicros;
+	uint8_t trigger;
+	HotkeyAction action;
+	uint32_t heldSince;
+	bool fired;
+};
+
+// Matches hotkey chords against the debounced GPIO word, so they mean the same buttons whatever
+// remap profile is active. Entries are sorted most specific first and a chord that's a subset of one
+// already held doesn't match. Fired actions are queued for the input loop to handle.
+class HotkeyEngine
+{
+public:
+	HotkeyEngine() : entryCount(0), modifierPins(0), activeMask(0), waitingMask(0), head(0), tail(0) {}
+
+	// Turn the bindings into pin masks, again whenever the pins are remapped
+	void compile(GamepadButtonMapping **mappings);
+
+	// Returns the pins of every chord being held, for the caller to hide from the state
+	inline uint32_t __attribute__((always_inline)) process(uint32_t pins, uint32_t nowMicros)
+	{
+		if (!(pins & modifierPins) && !activeMask) // Nothing to do without a modifier
+			return 0;
+		return match(pins, nowMicros);
+	}
+
+	bool pop(HotkeyAction &action);
+	bool held(uint8_t type); // A chord for this action type is down
+
+	// A held chord's HOLD or TAP hasn't fired yet, process() has to keep running even if no input changes
+	inline bool pending() { return waitingMask != 0; }
+
+private:
+	uint32_t match(uint32_t pins, uint32_t nowMicros);
+	void push(const HotkeyAction &action);
+
+	HotkeyEntry entries[HOTKEY_MAX_ENTRIES];
+	uint8_t entryCount;
+	uint32_t modifierPins; // Any of these down means a chord may be starting
+	uint32_t activeMask;   // Bit per entry whose chord is down
+	uint32_t waitingMask;  // Active entries with a HOLD or TAP still to fire
+	HotkeyAction queue[HOTKEY_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t tail;
+};
+
+#endif
@@ -20,7 +20,7 @@ class AnalogInput : public GPAddon {
 public:
 	virtual bool available();   // GPAddon available
 	virtual void setup();       // Analog Setup
-	virtual void process();     // Analog Process
+	virtual void process(const FrameContext &frame); // Analog Process
     virtual std::string name() { return AnalogName; }
 private:
 };
@@ -20,11 +20,12 @@ class JSliderInput : public GPAddon {
 public:
 	virtual bool available();   // GPAddon available
 	virtual void setup();       // JSlider Button Setup
-	virtual void process();     // JSlider process
+	virtual void process(const FrameContext &frame); // JSlider process
+	virtual bool dirty();       // JSlider debounce in flight
     virtual std::string name() { return JSliderName; }
 private:
     DpadMode read();
-    void debounce();
+    void debounce(uint32_t uNowTime);
     DpadMode dpadState;           // Saved locally for debounce
     DpadMode dDebState;          // Debounce JSlider State
     uint32_t uDebTime;          // Debounce JSlider Time
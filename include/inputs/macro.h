@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _MACRO_H_
+#define _MACRO_H_
+
+#include "gpaddon.h"
+
+// How far ahead of the report deadline a macro frame switches over, when phase-locked to USB SOF
+#ifndef GAMEPAD_MACRO_LEAD_MICRO
+#define GAMEPAD_MACRO_LEAD_MICRO 200
+#endif
+
+#define MACRO_STORAGE_BYTES 1012 // MacroStorage fills the 1024 bytes at MACRO_STORAGE_INDEX
+
+// Change header bits, each followed by the XOR of that part against the previous state
+#define MACRO_CHANGED_BUTTONS_LO 0x01
+#define MACRO_CHANGED_BUTTONS_HI 0x02
+#define MACRO_CHANGED_DPAD       0x04
+
+// Macro Module Name
+#define MacroName "Macro"
+
+// One recorded macro. data is a list of changes, each a LEB128 frame count since the previous change,
+// a MACRO_CHANGED_* header byte and the changed bytes. The last change releases everything.
+struct MacroStorage
+{
+	uint32_t frameMicros; // Frame period it was recorded at (the USB poll interval, up to 255ms)
+	uint16_t length;      // Bytes of data in use
+	uint8_t data[MACRO_STORAGE_BYTES];
+	uint32_t checksum;
+};
+
+static_assert(sizeof(MacroStorage) == 1024, "MacroStorage fills its EEPROM slot");
+
+// Records the processed buttons and d-pad once per USB frame, and plays them back from a hardware alarm
+// that steps one frame per period, re-armed from its previous target so loop jitter never adds up.
+// F1 + L3 held starts (and stops) recording, F1 + R3 plays the macro on top of whatever is held.
+class MacroInput : public GPAddon {
+public:
+	virtual bool available();
+	virtual void setup();
+	virtual void process(const FrameContext &frame);
+	virtual bool dirty();       // Recording, playing back, or playback just ended
+	virtual std::string name() { return MacroName; }
+
+	void step();                // Alarm IRQ: one playback frame
+
+	volatile uint32_t nextStep; // Alarm target of the next playback frame
+	volatile uint32_t sofPhase; // Where the next frame should start by the SOF estimate, 0 while unlocked
+	uint32_t periodMicros;      // Playback frame period
+private:
+	void startRecording(const FrameContext &frame);
+	void record(const FrameContext &frame);
+	void stopRecording(const FrameContext &frame);
+	void startPlayback(uint64_t now);
+	void stopPlayback();
+	bool append(uint32_t frames, uint32_t change, uint16_t limit);
+	void save();
+	MacroStorage macro;
+	uint32_t frameMicros;       // USB poll interval
+	int alarm;                  // Hardware alarm, -1 until the first playback
+
+	bool recording;
+	bool recordArmed;           // Waiting for every button to be let go before the first frame
+	uint64_t recordStart;
+	uint32_t recordFrame;       // Frame of the last change written
+	uint32_t recordState;       // buttons | dpad << 16, as of the last change written
+	uint16_t checkpointLength;  // End of the last change with no modifier held, where stopping cuts back to
+	uint32_t checkpointFrame;
+	uint32_t checkpointState;
+
+	volatile bool playing;
+	volatile bool playbackEnded; // Set by the alarm IRQ, the next frame still has to clear the last buttons
+	volatile uint32_t playState; // buttons | dpad << 16 of the current playback frame
+	uint16_t playCursor;
+	uint32_t framesUntilChange;
+};
+
+#endif
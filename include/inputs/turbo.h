@@ -23,15 +23,15 @@ class TurboInput : public GPAddon {
 public:
 	virtual bool available();   // GPAddon available
 	virtual void setup();       // TURBO Button Setup
-	virtual void process();     // TURBO Setting of buttons (Enable/Disable)
+	virtual void process(const FrameContext &frame); // TURBO Setting of buttons (Enable/Disable)
+	virtual bool dirty();       // TURBO timer or debounce in flight
     virtual std::string name() { return TurboName; }
 private:
     virtual bool read();        // Get TURBO Button State
-    virtual void debounce();    // TURBO Button Debouncer
+    virtual void debounce(uint32_t uNowTime); // TURBO Button Debouncer
+    void setShotCount(uint8_t shotCount);     // Save TURBO shots per second
     bool bDebState;             // Debounce TURBO Button State
     uint32_t uDebTime;          // Debounce TURBO Button Time
-    uint16_t lastPressed;       // Last buttons pressed (for Turbo Enable)
-    uint16_t lastDpad;          // Last d-pad pressed (for Turbo Change)
     uint16_t buttonsEnabled;    // Turbo Buttons Enabled
     uint32_t uIntervalMS;       // Turbo Interval
     bool bTurboState;           // Turbo Buttons State
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _INPUTTRACE_H_
+#define _INPUTTRACE_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+#include <MPGS.h>
+#include "hardware/timer.h"
+
+// Keep the last GAMEPAD_INPUT_TRACE_RECORDS states sent to the host, set to 0 to compile the trace out
+#ifndef GAMEPAD_INPUT_TRACE
+#define GAMEPAD_INPUT_TRACE 1
+#endif
+
+// Ring size, must be a power of 2. 24 bytes each.
+#ifndef GAMEPAD_INPUT_TRACE_RECORDS
+#define GAMEPAD_INPUT_TRACE_RECORDS 256
+#endif
+
+#define INPUT_TRACE_MAGIC   0x52545047 // "GPTR", little-endian
+#define INPUT_TRACE_VERSION 1
+
+// One state as it went out, also the export format (little-endian, no padding)
+struct InputTraceRecord
+{
+	uint32_t micros;  // time_us_32() right after send_report()
+	uint32_t gpio;    // Inverted, masked GPIO word the state was built from
+	uint16_t buttons;
+	uint16_t aux;
+	uint16_t lx;
+	uint16_t ly;
+	uint16_t rx;
+	uint16_t ry;
+	uint8_t dpad;
+	uint8_t lt;
+	uint8_t rt;
+	uint8_t reserved;
+};
+
+static_assert(sizeof(InputTraceRecord) == 24, "InputTraceRecord is the export format");
+
+// Leads the export, followed by count records oldest first
+struct InputTraceHeader
+{
+	uint32_t magic;      // INPUT_TRACE_MAGIC
+	uint16_t version;    // INPUT_TRACE_VERSION
+	uint16_t recordSize; // sizeof(InputTraceRecord)
+	uint32_t count;      // Records that follow
+	uint32_t captured;   // Records captured since the trace was cleared, count is the newest of them
+};
+
+struct InputTraceRing
+{
+	uint32_t magic;
+	uint32_t head; // Records captured, the next one goes in records[head % GAMEPAD_INPUT_TRACE_RECORDS]
+	InputTraceRecord records[GAMEPAD_INPUT_TRACE_RECORDS];
+};
+
+// RAM ring of every distinct state send_report() took. The ring isn't zeroed at startup, so a trace
+// survives the warm reboot into web config mode and can be downloaded from /api/getInputTrace.
+// Only written by whichever core sends reports.
+class InputTrace {
+public:
+	InputTrace(InputTrace const&) = delete;
+	void operator=(InputTrace const&)  = delete;
+	static InputTrace& getInstance()
+	{
+		static InputTrace instance;
+		return instance;
+	}
+
+	void setup(bool clear); // Start over, or keep what the last boot captured if it's intact
+
+	inline void __attribute__((always_inline)) capture(const GamepadState &state, uint32_t gpio)
+	{
+		InputTraceRecord &last = ring.records[(ring.head - 1) & (GAMEPAD_INPUT_TRACE_RECORDS - 1)];
+		if (ring.head && state.buttons == last.buttons && state.dpad == last.dpad && state.aux == last.aux
+			&& state.lx == last.lx && state.ly == last.ly && state.rx == last.rx && state.ry == last.ry
+			&& state.lt == last.lt && state.rt == last.rt)
+			return;
+
+		InputTraceRecord &record = ring.records[ring.head & (GAMEPAD_INPUT_TRACE_RECORDS - 1)];
+		record.micros  = timer_hw->timerawl;
+		record.gpio    = gpio;
+		record.buttons = state.buttons;
+		record.aux     = state.aux;
+		record.lx      = state.lx;
+		record.ly      = state.ly;
+		record.rx      = state.rx;
+		record.ry      = state.ry;
+		record.dpad    = state.dpad;
+		record.lt      = state.lt;
+		record.rt      = state.rt;
+		ring.head++;
+	}
+
+	inline uint32_t getCaptured() { return ring.head; }
+	inline uint32_t getCount() { return ring.head < GAMEPAD_INPUT_TRACE_RECORDS ? ring.head : GAMEPAD_INPUT_TRACE_RECORDS; }
+	const InputTraceRecord & getRecord(uint32_t index); // 0 is the oldest of getCount()
+
+private:
+	InputTrace();
+	InputTraceRing &ring;
+};
+
+#if GAMEPAD_INPUT_TRACE
+#define INPUT_TRACE_CAPTURE(state, gpio) InputTrace::getInstance().capture(state, gpio)
+#else
+#define INPUT_TRACE_CAPTURE(state, gpio)
+#endif
+
+#endif
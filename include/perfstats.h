@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _PERFSTATS_H_
+#define _PERFSTATS_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "BoardConfig.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+
+// Time each stage of the input loop, set to 0 to compile the profiler out
+#ifndef GAMEPAD_PERF_STATS
+#define GAMEPAD_PERF_STATS 1
+#endif
+
+#define PERF_MAX_STAGES     16
+#define PERF_HISTOGRAM_BINS 96 // Log-linear bins, 4 per power of 2, covers the full 24-bit SysTick range
+
+enum PerfStage
+{
+	PERF_STAGE_READ,
+	PERF_STAGE_DEBOUNCE,
+	PERF_STAGE_HOTKEY,
+	PERF_STAGE_PROCESS,
+	PERF_STAGE_COPY,
+	PERF_STAGE_SEND_REPORT,
+	PERF_STAGE_RECEIVE_REPORT,
+	PERF_STAGE_TUD_TASK,
+	PERF_STAGE_REPORT_AGE, // Input sample to send_report, the same measure for either core layout
+	PERF_STAGE_INPUTS, // Storage::Inputs addons follow in registration order
+};
+
+struct PerfStageStats
+{
+	std::string name;
+	uint32_t count;
+	uint32_t minCycles;
+	uint32_t maxCycles;
+	uint64_t totalCycles;
+	uint32_t binTotal;                     // Samples currently in the histogram (halves on saturation)
+	uint16_t bins[PERF_HISTOGRAM_BINS];
+
+	uint32_t percentile(uint8_t percent) const; // Upper bound of the bin holding this percentile, in cycles
+};
+
+// Per-stage cycle profiler. The M0+ has no DWT cycle counter, so this uses SysTick at the core clock.
+// SysTick is per core, each core that profiles calls setupCore(), and stages are only recorded from one core each.
+class PerfStats {
+public:
+	PerfStats(PerfStats const&) = delete;
+	void operator=(PerfStats const&)  = delete;
+	static PerfStats& getInstance()
+	{
+		static PerfStats instance;
+		return instance;
+	}
+
+	void setup();
+	void setupCore(); // Start this core's SysTick
+	uint8_t addStage(const std::string &name);
+	void reset();
+
+	inline void __attribute__((always_inline)) begin() { mark[get_core_num()] = systick_hw->cvr; }
+
+	// Record the cycles since begin() or the previous end() against this stage
+	inline void __attribute__((always_inline)) end(uint8_t stage)
+	{
+		uint32_t &coreMark = mark[get_core_num()];
+		record(stage, (coreMark - systick_hw->cvr) & 0x00FFFFFF); // SysTick counts down
+		coreMark = systick_hw->cvr;
+	}
+
+	void recordMicros(uint8_t stage, uint32_t micros); // For spans SysTick can't time, like across cores
+
+	inline uint8_t getStageCount() { return stageCount; }
+	inline const PerfStageStats & getStage(uint8_t stage) { return stages[stage]; }
+
+private:
+	PerfStats() : stageCount(0), cyclesPerMicro(0), mark{0, 0} {}
+	void record(uint8_t stage, uint32_t cycles);
+	PerfStageStats stages[PERF_MAX_STAGES];
+	uint8_t stageCount;
+	uint32_t cyclesPerMicro;
+	uint32_t mark[2]; // Per core
+};
+
+#if GAMEPAD_PERF_STATS
+#define PERF_BEGIN()    PerfStats::getInstance().begin()
+#define PERF_END(stage) PerfStats::getInstance().end(stage)
+#define PERF_RECORD_MICROS(stage, micros) PerfStats::getInstance().recordMicros(stage, micros)
+#else
+#define PERF_BEGIN()
+#define PERF_END(stage)
+#define PERF_RECORD_MICROS(stage, micros)
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _PIOSAMPLER_H_
+#define _PIOSAMPLER_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+
+// Sample the GPIOs continuously with a PIO state machine, so reads see every transition since the last loop
+#ifndef GAMEPAD_PIO_SAMPLER
+#define GAMEPAD_PIO_SAMPLER 0
+#endif
+
+#ifndef GAMEPAD_PIO_SAMPLE_HZ
+#define GAMEPAD_PIO_SAMPLE_HZ 1000000
+#endif
+
+#define PIO_SAMPLE_RING_SIZE 4096 // Words, must be a power of 2. 4ms of history at 1MHz
+
+// PIO state machine (pio1) pushing one GPIO word per sample, DMA writing them round a RAM ring.
+// A second DMA channel re-arms the first each time it reaches the end of the ring, so the CPU never touches it.
+class PioSampler {
+public:
+	PioSampler(PioSampler const&) = delete;
+	void operator=(PioSampler const&)  = delete;
+	static PioSampler& getInstance()
+	{
+		static PioSampler instance;
+		return instance;
+	}
+
+	void setup();
+
+	// Walk every sample since the last read(). Stores the time of each pin's last edge in edgeMicros, and returns
+	// the inverted (1 = pressed) pins that were pressed at any point, so pulses shorter than the loop still register.
+	uint32_t read(uint32_t pinMask, uint32_t *edgeMicros);
+
+	// True if any of these pins changed in samples not yet seen by read() or changed(). Samples before the first
+	// change are consumed, so an idle controller keeps up with the ring and read() starts from that change.
+	bool changed(uint32_t pinMask);
+
+	uint32_t overruns; // The ring wrapped over samples neither read() nor changed() had consumed
+
+private:
+	PioSampler() : overruns(0), readIndex(0), peekIndex(0), lastSample(0), readMicros(0), dataChannel(-1), controlChannel(-1) {}
+	uint32_t writeIndex();
+
+	uint32_t ring[PIO_SAMPLE_RING_SIZE];
+	uint32_t *ringStart;     // Read by the control DMA channel
+	uint32_t readIndex;      // Oldest sample not consumed yet
+	uint32_t peekIndex;
+	uint32_t lastSample;     // Inverted, unmasked word at readIndex - 1
+	uint32_t readMicros;     // About when the DMA wrote (or will write) ring[readIndex]
+	int dataChannel;
+	int controlChannel;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "pico/stdlib.h"
+
+#define SCHEDULER_MAX_TASKS 8
+
+class GPAddon;
+
+// How an addon wants to be run by the core1 scheduler
+struct AddonSchedule
+{
+	uint32_t periodMicros; // 0 = every pass
+	uint8_t priority;      // Lower runs first when several tasks are due
+	uint32_t budgetMicros; // Expected worst case, 0 = not checked
+};
+
+struct SchedulerTask
+{
+	GPAddon *addon;
+	AddonSchedule schedule;
+	uint32_t nextRun;      // time_us_32() the task is due
+	uint32_t runs;
+	uint32_t misses;       // Started a whole period late, the missed slots were skipped
+	uint32_t overruns;     // Ran longer than its budget
+	uint32_t maxMicros;
+	uint64_t totalMicros;
+};
+
+// Cooperative scheduler for the aux addons. Runs the most urgent due task, one at a time,
+// and sleeps the core with __wfe until the next one is due or an event comes in.
+// With CORE_LAYOUT_INPUT_CORE it shares core0 with USB, which calls poll() between reports instead of run().
+class Scheduler {
+public:
+	Scheduler(Scheduler const&) = delete;
+	void operator=(Scheduler const&)  = delete;
+	static Scheduler& getInstance()
+	{
+		static Scheduler instance;
+		return instance;
+	}
+
+	void setup(std::vector<GPAddon*> &addons); // Every set up addon becomes a task
+	void run();                                // Never returns
+	int32_t poll();                            // Run at most one due task, 0 if one ran, else micros until the next is due
+	static void sleepUntil(uint64_t micros);   // Either core, wakes early on __sev
+
+	inline uint8_t getTaskCount() { return taskCount; }
+	inline const SchedulerTask & getTask(uint8_t index) { return tasks[index]; }
+
+private:
+	Scheduler() : taskCount(0) {}
+	SchedulerTask *nextDue(uint32_t now, int32_t &waitMicros);
+	void runTask(SchedulerTask &task, uint32_t now);
+
+	SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+	uint8_t taskCount;
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Single-writer/multi-reader snapshot for passing plain data between cores without locks.
+// The sequence is odd while a write is in progress; readers copy, then retry if it moved under them.
+// Nothing is cached on the RP2040, so __dmb() is all the ordering either core needs.
+template <typename T>
+class SeqLock
+{
+public:
+	SeqLock() : sequence(0) {}
+
+	void write(const T &value) // One writer only
+	{
+		sequence = sequence + 1;
+		__dmb();
+		memcpy(&data, &value, sizeof(T));
+		__dmb();
+		sequence = sequence + 1;
+	}
+
+	// Copy out a consistent snapshot, returns its version
+	uint32_t read(T &value) const
+	{
+		uint32_t start;
+		do
+		{
+			while ((start = sequence) & 1)
+				tight_loop_contents();
+			__dmb();
+			memcpy(&value, &data, sizeof(T));
+			__dmb();
+		} while (sequence != start);
+
+		return start >> 1;
+	}
+
+	inline uint32_t version() const { return sequence >> 1; } // Count of completed writes
+
+private:
+	volatile uint32_t sequence;
+	T data;
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _SOCD_H_
+#define _SOCD_H_
+
+#include <stdint.h>
+#include <MPGS.h>
+
+// SOCD modes past the MPGS SOCDMode values, kept in the same GamepadOptions.socdMode
+#define SOCD_MODE_FIRST_INPUT_PRIORITY                     ((SOCDMode)3)
+#define SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL      ((SOCDMode)4) // Up + Down = Up, Left + Right = last input
+#define SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL ((SOCDMode)5) // Up + Down = last input, Left + Right = Neutral
+#define SOCD_MODE_COUNT 6
+
+// What one axis does when both of its directions are held
+typedef enum
+{
+	SOCD_AXIS_NEUTRAL,     // Both cancel out
+	SOCD_AXIS_NEGATIVE,    // Up or Left wins
+	SOCD_AXIS_POSITIVE,    // Down or Right wins
+	SOCD_AXIS_LAST_INPUT,  // The later press wins
+	SOCD_AXIS_FIRST_INPUT, // The earlier press wins
+} SOCDAxisRule;
+
+// Settles opposing directions with a single table lookup. The table is indexed by the 4 d-pad bits plus
+// which direction of each axis was pressed last, and is rebuilt whenever the mode changes.
+class SOCDCleaner
+{
+public:
+	SOCDCleaner();
+
+	void setMode(uint8_t mode);
+	inline uint8_t getMode() { return mode; }
+
+	// pressMicros: time each direction (Up, Down, Left, Right) was last pressed, equal times count Up/Left as last
+	inline uint8_t __attribute__((always_inline)) process(uint8_t dpad, const uint32_t pressMicros[4])
+	{
+		uint32_t downLast  = (uint32_t)((int32_t)(pressMicros[0] - pressMicros[1])) >> 31;
+		uint32_t rightLast = (uint32_t)((int32_t)(pressMicros[2] - pressMicros[3])) >> 31;
+		return table[(dpad & 0x0F) | (downLast << 4) | (rightLast << 5)];
+	}
+
+private:
+	uint8_t table[64];
+	uint8_t mode;
+};
+
+#endif
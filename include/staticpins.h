@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _STATICPINS_H_
+#define _STATICPINS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+#include <MPGS.h>
+#include "BoardConfig.h"
+
+// Included from gamepad.h, after the GAMEPAD_LUT_* packing is defined
+
+// Translate with the BoardConfig.h pins baked in while the stored mapping still matches them.
+// Off by default, the fold is one shift and mask per pin and test/bench_translate has it slower than the tables.
+#ifndef GAMEPAD_STATIC_PINS
+#define GAMEPAD_STATIC_PINS 0
+#endif
+
+#if GAMEPAD_STATIC_PINS
+
+struct StaticPinMapping
+{
+	uint8_t pin;
+	uint16_t buttonMask;
+	bool isDpad;
+};
+
+// Same order as Gamepad::gamepadMappings
+static constexpr StaticPinMapping staticPinMappings[GAMEPAD_DIGITAL_INPUT_COUNT] =
+{
+	{ PIN_DPAD_UP,    GAMEPAD_MASK_UP,    true },
+	{ PIN_DPAD_DOWN,  GAMEPAD_MASK_DOWN,  true },
+	{ PIN_DPAD_LEFT,  GAMEPAD_MASK_LEFT,  true },
+	{ PIN_DPAD_RIGHT, GAMEPAD_MASK_RIGHT, true },
+	{ PIN_BUTTON_B1,  GAMEPAD_MASK_B1,    false },
+	{ PIN_BUTTON_B2,  GAMEPAD_MASK_B2,    false },
+	{ PIN_BUTTON_B3,  GAMEPAD_MASK_B3,    false },
+	{ PIN_BUTTON_B4,  GAMEPAD_MASK_B4,    false },
+	{ PIN_BUTTON_L1,  GAMEPAD_MASK_L1,    false },
+	{ PIN_BUTTON_R1,  GAMEPAD_MASK_R1,    false },
+	{ PIN_BUTTON_L2,  GAMEPAD_MASK_L2,    false },
+	{ PIN_BUTTON_R2,  GAMEPAD_MASK_R2,    false },
+	{ PIN_BUTTON_S1,  GAMEPAD_MASK_S1,    false },
+	{ PIN_BUTTON_S2,  GAMEPAD_MASK_S2,    false },
+	{ PIN_BUTTON_L3,  GAMEPAD_MASK_L3,    false },
+	{ PIN_BUTTON_R3,  GAMEPAD_MASK_R3,    false },
+	{ PIN_BUTTON_A1,  GAMEPAD_MASK_A1,    false },
+	{ PIN_BUTTON_A2,  GAMEPAD_MASK_A2,    false },
+};
+
+// Output bits (LUT packing: buttons | dpad << GAMEPAD_LUT_DPAD_SHIFT) of one mapping, with Y-axis inversion applied
+static constexpr uint32_t staticPinOutput(size_t index, bool invertYAxis)
+{
+	return !staticPinMappings[index].isDpad ? staticPinMappings[index].buttonMask
+		: (uint32_t)((invertYAxis && index == 0) ? GAMEPAD_MASK_DOWN
+		: (invertYAxis && index == 1) ? GAMEPAD_MASK_UP
+		: staticPinMappings[index].buttonMask) << GAMEPAD_LUT_DPAD_SHIFT;
+}
+
+// Every term is a constant shift and mask of the GPIO word, the compiler folds the whole thing
+template <bool invertYAxis, size_t... I>
+inline uint32_t __attribute__((always_inline)) staticTranslate(uint32_t values, std::index_sequence<I...>)
+{
+	uint32_t output = 0;
+	#ifdef PIN_SETTINGS
+	output |= ((values >> PIN_SETTINGS) & 1) << (GAMEPAD_LUT_AUX_SHIFT + 0);
+	#endif
+	int expand[] = { 0, (output |= ((values >> staticPinMappings[I].pin) & 1) * staticPinOutput(I, invertYAxis), 0)... };
+	(void)expand;
+	return output;
+}
+
+template <bool invertYAxis>
+inline uint32_t __attribute__((always_inline)) staticTranslate(uint32_t values)
+{
+	return staticTranslate<invertYAxis>(values, std::make_index_sequence<GAMEPAD_DIGITAL_INPUT_COUNT>{});
+}
+
+#endif
+
+#endif
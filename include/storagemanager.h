@@ -14,14 +14,20 @@
 #include "helper.h"
 #include "gamepad.h"
 #include "gpaddon.h"
+#include "seqlock.h"
 
 #define GAMEPAD_STORAGE_INDEX      0 // 1024 bytes for gamepad options
 #define BOARD_STORAGE_INDEX     1024 //  512 bytes for hardware options
 #define LED_STORAGE_INDEX       1536 //  512 bytes for LED configuration
-#define ANIMATION_STORAGE_INDEX 2048 // ???? bytes for LED animations
+#define ANIMATION_STORAGE_INDEX 2048 //  512 bytes for LED animations
+#define SWITCH_STATS_STORAGE_INDEX 2560 // 512 bytes for switch actuation counters
+#define MACRO_STORAGE_INDEX     3072 // 1024 bytes for the recorded macro
 
 #define CHECKSUM_MAGIC          0 	// Checksum CRC
 
+#define GAMEPAD_REMAP_PROFILES  4   // Button remap profiles, F2 + L1/R1/L2/R2 switches between them
+#define GAMEPAD_REMAP_NONE      0xFF // Input sends nothing
+
 struct BoardOptions
 {
 	bool hasBoardOptions;
@@ -58,10 +64,24 @@ struct BoardOptions
 	bool displayInvert;
 	uint8_t turboShotCount; // Turbo
 	uint8_t pinTurboLED;    // Turbo LED
+	uint8_t pollInterval;   // USB poll interval in ms, 0 = input mode default
+	uint8_t debounceMode;   // DebounceMode
+	uint16_t debounceMicros[GAMEPAD_DIGITAL_INPUT_COUNT]; // Per button, same order as Gamepad::gamepadMappings
+	uint8_t remapProfiles[GAMEPAD_REMAP_PROFILES][GAMEPAD_DIGITAL_INPUT_COUNT]; // Button each input sends (gamepadMappings index), per profile
+	uint8_t remapProfile;   // Profile used at boot
 	char boardVersion[32]; // 32-char limit to board name
 	uint32_t checksum;
 };
 
+// Everything the addon/USB side reads from the input loop, published as a whole
+struct GamepadSnapshot
+{
+	GamepadState state;      // Processed gamepad state
+	uint32_t micros;         // time_us_32() of the input sample behind it
+	uint32_t gpio;           // Inverted, masked GPIO word the state was built from
+	uint32_t pressMicros;    // Raw edge time of the latest debounced press, kept until the next one
+};
+
 struct LEDOptions
 {
 	bool useUserDefinedLEDs;
@@ -109,6 +129,7 @@ public:
 	void setBoardOptions(BoardOptions);	// Board Options
 	void setDefaultBoardOptions();
 	BoardOptions getBoardOptions();
+	inline const BoardOptions & getBoardOptionsRef() { return boardOptions; } // Read-only, no copy
 
 	void setLEDOptions(LEDOptions);		// LED Options
 	void setDefaultLEDOptions();
@@ -127,13 +148,21 @@ public:
 	void ClearFeatureData();
 	uint8_t * GetFeatureData();
 
+	void PublishGamepadState(Gamepad *, uint32_t micros); // Input loop to snapshot (and EVENT_INPUT), a new version only when something changed
+	void PublishFeatureData();          // After receive_report() into GetFeatureData(), EVENT_USB_OUT_REPORT when it changed
+	uint32_t SyncSnapshot();            // Core1: refresh GetProcessedGamepad(), returns the version
+	inline uint32_t GetSnapshotVersion() { return syncedVersion; }
+	inline uint32_t GetSnapshotMicros() { return synced.micros; }
+	inline uint32_t GetSnapshotGpio() { return synced.gpio; }
+	inline uint32_t GetSnapshotPressMicros() { return synced.pressMicros; }
+
 	void ResetSettings(); 				// EEPROM Reset Feature
 	
 	std::vector<GPAddon*> Addons;		// Modular Features
 	std::vector<GPAddon*> Inputs;
 
 private:
-	Storage() : gamepad(0) {
+	Storage() : gamepad(0), syncedVersion(0) {
 		EEPROM.start(); // init EEPROM
 		initBoardOptions();
 		initLEDOptions();
@@ -145,7 +174,12 @@ private:
 	Gamepad * processedGamepad; // Gamepad with ONLY processed data
 	BoardOptions boardOptions;
 	LEDOptions ledOptions;
-	uint8_t featureData[32]; // USB X-Input Feature Data
+	uint8_t featureData[32]; // USB X-Input Feature Data, core0 working copy
+	GamepadSnapshot published;         // Input loop: last snapshot written
+	uint8_t publishedFeatureData[32];  // Core0: last EVENT_USB_OUT_REPORT
+	SeqLock<GamepadSnapshot> snapshot;
+	GamepadSnapshot synced;            // Reader: last snapshot read
+	uint32_t syncedVersion;
 };
 
 #endif
@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#ifndef _SWITCHSTATS_H_
+#define _SWITCHSTATS_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+#include "hardware/platform_defs.h"
+
+// Count actuations, bounce and chatter per switch, set to 0 to compile it out
+#ifndef GAMEPAD_SWITCH_STATS
+#define GAMEPAD_SWITCH_STATS 1
+#endif
+
+// Raw edges of a pin closer together than this are one actuation (or glitch) bouncing
+#ifndef GAMEPAD_BOUNCE_WINDOW_MICROS
+#define GAMEPAD_BOUNCE_WINDOW_MICROS 10000
+#endif
+
+// Shortest time between two flash writes of the lifetime counters
+#ifndef GAMEPAD_SWITCH_STATS_CHECKPOINT_MINUTES
+#define GAMEPAD_SWITCH_STATS_CHECKPOINT_MINUTES 30
+#endif
+
+#define SWITCH_STATS_BINS         52      // Exact below 8us, then 4 bins per power of 2, the last one takes everything past ~16ms
+#define SWITCH_STATS_IDLE_MICROS  5000000 // A checkpoint waits until no switch has moved for this long
+#define SWITCH_STATS_RETRY_MICROS 1000000
+#define SWITCH_STATS_MAGIC        0x53575347 // "GSWS"
+
+// Lifetime counters, checkpointed to flash
+struct SwitchCounters
+{
+	uint32_t actuations; // Debounced presses
+	uint32_t bounces;    // Actuations that took more than one raw edge to settle
+	uint32_t chatters;   // Raw pulses that came and went without changing the level
+};
+
+struct SwitchStatsStorage
+{
+	SwitchCounters pins[NUM_BANK0_GPIOS];
+	uint32_t checksum;
+};
+
+struct SwitchPinStats
+{
+	SwitchCounters counters;
+	uint32_t maxBounceMicros;                // Since power-on
+	uint16_t bounceBins[SWITCH_STATS_BINS];  // Bounce durations since power-on, first to last raw edge
+	uint32_t burstStart;                     // Raw edges of the burst in progress
+	uint32_t burstLast;
+	uint8_t burstEdges;
+};
+
+struct SwitchStatsStore
+{
+	uint32_t magic;
+	SwitchPinStats pins[NUM_BANK0_GPIOS];
+};
+
+// Per-switch health: every raw edge is grouped into bursts, an odd burst of 3+ edges is a bounce and
+// an even one is chatter. Counters and histograms live in RAM the C runtime doesn't clear, so they
+// make it through the warm reboot into web config mode. The lifetime counters are also written to
+// flash, rarely and only while the controller is idle, since a flash write stalls the inputs.
+class SwitchStats {
+public:
+	SwitchStats(SwitchStats const&) = delete;
+	void operator=(SwitchStats const&)  = delete;
+	static SwitchStats& getInstance()
+	{
+		static SwitchStats instance;
+		return instance;
+	}
+
+	void setup(bool configMode);
+
+	// Raw levels from the input loop, changeMicros as for Debouncer::process()
+	inline void __attribute__((always_inline)) sample(uint32_t raw, uint32_t nowMicros, const uint32_t *changeMicros = nullptr)
+	{
+		for (uint32_t changed = raw ^ lastRaw; changed; changed &= changed - 1)
+		{
+			uint8_t pin = __builtin_ctz(changed);
+			edge(pin, changeMicros ? changeMicros[pin] : nowMicros);
+		}
+		lastRaw = raw;
+	}
+
+	void edge(uint8_t pin, uint32_t micros); // One raw edge, when the caller sees each of them (edge IRQ)
+
+	inline void __attribute__((always_inline)) actuated(uint32_t pins)
+	{
+		if (!pins)
+			return;
+
+		for (; pins; pins &= pins - 1)
+			store.pins[__builtin_ctz(pins)].counters.actuations++;
+		dirty = true;
+	}
+
+	// Call from the main loop, writes the counters out when they're due and the switches are idle
+	inline void __attribute__((always_inline)) checkpoint(uint64_t nowMicros)
+	{
+		if (nowMicros >= nextCheckpoint)
+			save(nowMicros);
+	}
+
+	const SwitchPinStats & getPin(uint8_t pin) { return store.pins[pin]; }
+	uint32_t percentile(uint8_t pin, uint8_t percent); // Upper bound of the bin, in us
+
+private:
+	SwitchStats();
+	void finish(SwitchPinStats &stats);
+	void save(uint64_t nowMicros);
+	SwitchStatsStore &store;
+	uint32_t lastRaw;
+	uint32_t lastEdgeMicros;
+	uint64_t nextCheckpoint;
+	bool dirty;
+};
+
+#if GAMEPAD_SWITCH_STATS
+#define SWITCH_STATS_SAMPLE(raw, now, changeMicros) SwitchStats::getInstance().sample(raw, now, changeMicros)
+#define SWITCH_STATS_EDGE(pin, micros)              SwitchStats::getInstance().edge(pin, micros)
+#define SWITCH_STATS_ACTUATED(pins)                 SwitchStats::getInstance().actuated(pins)
+#define SWITCH_STATS_CHECKPOINT(nowMicros)          SwitchStats::getInstance().checkpoint(nowMicros)
+#else
+#define SWITCH_STATS_SAMPLE(raw, now, changeMicros)
+#define SWITCH_STATS_EDGE(pin, micros)
+#define SWITCH_STATS_ACTUATED(pins)
+#define SWITCH_STATS_CHECKPOINT(nowMicros)
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Log-linear histogram bins shared by the profiler, latency and switch histograms: exact below 8, then
+// 4 bins per power of 2, so each bin is within 25% of its value. 4 * n - 4 bins cover n-bit values.
+
+// Bin of a value, anything past the last bin lands in it
+static inline uint8_t logBinFor(uint32_t value, uint8_t bins)
+{
+	if (value < 8)
+		return value;
+
+	uint32_t msb = 31 - __builtin_clz(value);
+	uint32_t bin = ((msb - 1) * 4) + ((value >> (msb - 2)) & 3);
+	return bin < bins ? bin : bins - 1;
+}
+
+// Largest value that lands in a bin
+static inline uint32_t logBinUpper(uint8_t bin)
+{
+	if (bin < 8)
+		return bin;
+
+	uint32_t shift = (bin / 4) - 1;
+	return (((4 + (bin % 4)) << shift) + (1 << shift)) - 1;
+}
+
+// Upper bound of the bin holding this percentile of total samples, 0 while empty
+template <typename T>
+static inline uint32_t logBinPercentile(const T *counts, uint8_t bins, uint32_t total, uint8_t percent)
+{
+	uint32_t target = ((uint64_t)total * percent + 99) / 100;
+	uint32_t seen = 0;
+	for (uint8_t bin = 0; bin < bins; bin++)
+	{
+		seen += counts[bin];
+		if (seen >= target && seen > 0)
+			return logBinUpper(bin);
+	}
+
+	return 0;
+}
@@ -758,6 +758,24 @@ static void SharpDumpBuffer(OBDISP *pOBD, uint8_t *pBuffer)
 // Try to speed it up by comparing the new bytes with the existing buffer
 //
 void obdDumpBuffer(OBDISP *pOBD, uint8_t *pBuffer)
+{
+	if (pOBD->type == LCD_VIRTUAL) // wrong function for this type of display
+		return;
+	if (pOBD->type >= SHARP_144x168) // special case for Sharp Memory LCD
+	{
+		if (pBuffer == NULL) // dump the internal buffer if none is given
+			pBuffer = pOBD->ucScreen;
+		if (pBuffer != NULL)
+			SharpDumpBuffer(pOBD, pBuffer);
+		return;
+	}
+	obdDumpPages(pOBD, pBuffer, 0, pOBD->height >> 3);
+} /* obdDumpBuffer() */
+//
+// Dump a range of 8-pixel pages to the display, so a slow bus
+// can be spread over several calls
+//
+void obdDumpPages(OBDISP *pOBD, uint8_t *pBuffer, int iStartPage, int iPageCount)
 {
 	int x, y, iPitch;
 	int iLines, iCols;
@@ -765,21 +783,23 @@ void obdDumpBuffer(OBDISP *pOBD, uint8_t *pBuffer)
 	uint8_t *pSrc = pOBD->ucScreen;
 
 	iPitch = pOBD->width;
-	if (pOBD->type == LCD_VIRTUAL) // wrong function for this type of display
+	if (pOBD->type == LCD_VIRTUAL || pOBD->type >= SHARP_144x168) // no pages on these
 		return;
 	if (pBuffer == NULL) // dump the internal buffer if none is given
 		pBuffer = pOBD->ucScreen;
 	if (pBuffer == NULL)
 		return; // no backbuffer and no provided buffer
 
-	if (pOBD->type >= SHARP_144x168) // special case for Sharp Memory LCD
-	{
-		SharpDumpBuffer(pOBD, pBuffer);
-		return;
-	}
 	iLines = pOBD->height >> 3;
 	iCols = pOBD->width >> 4;
-	for (y = 0; y < iLines; y++)
+	if (iStartPage < 0 || iStartPage >= iLines)
+		return;
+	if (iStartPage + iPageCount > iLines)
+		iPageCount = iLines - iStartPage;
+	if (pSrc != NULL)
+		pSrc += iStartPage * iPitch;
+	pBuffer += iStartPage * iPitch;
+	for (y = iStartPage; y < iStartPage + iPageCount; y++)
 	{
 		bNeedPos = 1;               // start of a new line means we need to set the position too
 		for (x = 0; x < iCols; x++) // wiring library has a 32-byte buffer, so send 16 bytes so that the data prefix (0x40) can fit
@@ -805,7 +825,7 @@ void obdDumpBuffer(OBDISP *pOBD, uint8_t *pBuffer)
 		pBuffer += (iPitch - pOBD->width);
 	} // for y
 	obdCachedFlush(pOBD, 1);
-} /* obdDumpBuffer() */
+} /* obdDumpPages() */
 
 // A valid CW or CCW move returns 1 or -1, invalid returns 0.
 static int obdMenuReadRotary(SIMPLEMENU *sm)
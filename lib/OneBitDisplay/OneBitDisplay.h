@@ -281,6 +281,11 @@ int obdSetPixel(OBDISP *pOBD, int x, int y, unsigned char ucColor, int bRender);
 //
 void obdDumpBuffer(OBDISP *pOBD, uint8_t *pBuffer);
 //
+// Dump iPageCount 8-pixel pages starting at iStartPage, same as obdDumpBuffer
+// otherwise. Not supported on virtual displays or the Sharp Memory LCD
+//
+void obdDumpPages(OBDISP *pOBD, uint8_t *pBuffer, int iStartPage, int iPageCount);
+//
 // Render a window of pixels from a provided buffer or the library's internal buffer
 // to the display. The row values refer to byte rows, not pixel rows due to the memory
 // layout of OLEDs. Pass a src pointer of NULL to use the internal backing buffer
@@ -0,0 +1,30 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define INPUT_LATENCY_MODES 3  // InputMode values below this get their own histogram (XInput, Switch, HID)
+#define INPUT_LATENCY_BINS  64 // Exact below 8us, then 4 bins per power of 2, the last one takes everything past ~65ms
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t maxMicros;
+	uint32_t bins[INPUT_LATENCY_BINS];
+} InputLatencyStats;
+
+// App hooks
+void input_latency_setup(bool clear);            // Start over, or keep what the last boot measured if it's intact
+void input_latency_press(uint32_t edgeMicros);   // The report being built carries a press first seen at edgeMicros
+
+// Driver hooks
+void input_latency_report_armed(void);     // send_report() queued a new report
+void input_latency_report_unchanged(void); // send_report() had nothing new to send
+void input_latency_report_sent(void);      // IN transfer completed
+
+const InputLatencyStats *input_latency_get_stats(uint8_t mode); // NULL if the mode isn't tracked
+uint32_t input_latency_percentile(const InputLatencyStats *stats, uint8_t percent); // Upper bound of the bin, in us
@@ -0,0 +1,39 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define SOF_FRAME_MICROS  1000 // Full-speed USB frame period
+#define SOF_LOCK_FRAMES   16   // Consecutive good frames before the phase estimate is trusted
+#define SOF_LOCK_ERROR    250  // Max phase error (us) tolerated while locked
+
+typedef struct
+{
+	uint32_t frames;        // SOF packets seen
+	uint32_t lockedFrames;  // SOF packets seen while phase-locked
+	uint32_t lockLosses;    // Times the lock dropped (missed frames, reset, suspend)
+	uint32_t reports;       // IN transfers completed
+	uint32_t inPhaseMicros; // Learned offset from the polled frame's SOF to IN completion
+	uint32_t jitterMicros;  // Average absolute SOF phase error
+	uint32_t lastAgeMicros; // Input sample to IN completion, last report
+	uint32_t avgAgeMicros;  // Input sample to IN completion, running average
+	uint32_t maxAgeMicros;  // Input sample to IN completion, worst case
+} SOFStats;
+
+// Driver hooks
+void sof_sync_enable(void);
+void sof_sync_set_interval(uint8_t frames);
+void sof_sync_frame(void);
+void sof_sync_report_armed(void);
+void sof_sync_report_sent(void);
+
+// Scheduler interface
+void sof_sync_input_sampled(uint64_t sampleMicros);
+bool sof_sync_locked(void);
+uint64_t sof_sync_next_deadline(uint64_t nowMicros, uint32_t leadMicros);
+uint64_t sof_sync_next_frame(uint64_t nowMicros); // Expected time of the next SOF
+const SOFStats *sof_sync_get_stats(void);
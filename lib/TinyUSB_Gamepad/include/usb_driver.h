@@ -7,6 +7,8 @@
 
 #include "GamepadDescriptors.h"
 
+#define USB_RECONNECT_MICROS 50000 // Time disconnected when switching input modes, long enough for the host to see the detach
+
 typedef enum
 {
 	USB_MODE_HID,
@@ -14,7 +16,10 @@ typedef enum
 } UsbMode;
 
 InputMode get_input_mode(void);
-void initialize_driver(InputMode mode);
+uint8_t get_poll_interval(void);
+void initialize_driver(InputMode mode, uint8_t pollInterval = 0); // pollInterval: report bInterval in ms, 0 keeps the descriptor's own
 void receive_report(uint8_t *buffer);
-void send_report(void *report, uint16_t report_size);
+bool send_report(void *report, uint16_t report_size); // true once the host has (or is being sent) this report
+bool switch_input_mode(InputMode mode); // Re-enumerate as another gamepad type, false if not possible
+void usb_driver_task(void);             // Call every loop, finishes a pending input mode switch
 
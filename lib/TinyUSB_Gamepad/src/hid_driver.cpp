@@ -5,6 +5,8 @@
 
 #include "hid_driver.h"
 #include "usb_driver.h"
+#include "sof_sync.h"
+#include "input_latency.h"
 
 #include "device/usbd_pvt.h"
 #include "class/hid/hid_device.h"
@@ -38,6 +40,24 @@ bool hid_device_control_request(uint8_t rhport, tusb_control_request_t const * r
 	}
 }
 
+static bool hid_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+	if (tu_edpt_dir(ep_addr) == TUSB_DIR_IN)
+	{
+		sof_sync_report_sent();
+		input_latency_report_sent();
+	}
+
+	return hidd_xfer_cb(rhport, ep_addr, result, xferred_bytes);
+}
+
+static void hid_sof(uint8_t rhport)
+{
+	(void)rhport;
+
+	sof_sync_frame();
+}
+
 const usbd_class_driver_t hid_driver = {
 #if CFG_TUSB_DEBUG >= 2
 	.name = "HID",
@@ -47,6 +67,6 @@ const usbd_class_driver_t hid_driver = {
 	.open = hidd_open,
 	.control_request = hid_device_control_request,
 	.control_complete = hidd_control_complete,
-	.xfer_cb = hidd_xfer_cb,
-	.sof = NULL
+	.xfer_cb = hid_xfer_cb,
+	.sof = hid_sof
 };
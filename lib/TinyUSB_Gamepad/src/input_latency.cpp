@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "input_latency.h"
+#include "usb_driver.h"
+
+#include <string.h>
+
+#include "pico/platform.h"
+#include "hardware/timer.h"
+#include "LogBins.h"
+
+#define INPUT_LATENCY_MAGIC 0x4C415447 // "GTAL"
+
+typedef struct
+{
+	uint32_t magic;
+	InputLatencyStats modes[INPUT_LATENCY_MODES];
+} InputLatencyStore;
+
+// Not zeroed at startup, web config shows what the gamepad boot measured
+static InputLatencyStore __uninitialized_ram(store);
+
+static uint32_t pendingEdge = 0;  // Oldest press not in a report yet
+static bool pending = false;
+static uint32_t armedEdge = 0;    // Press carried by the report waiting on the IN endpoint
+static bool armed = false;
+
+void input_latency_setup(bool clear)
+{
+	if (clear || store.magic != INPUT_LATENCY_MAGIC)
+	{
+		memset(&store, 0, sizeof(store));
+		store.magic = INPUT_LATENCY_MAGIC;
+	}
+
+	pending = false;
+	armed = false;
+}
+
+void input_latency_press(uint32_t edgeMicros)
+{
+	if (!pending || (int32_t)(edgeMicros - pendingEdge) < 0)
+		pendingEdge = edgeMicros;
+	pending = true;
+}
+
+void input_latency_report_armed(void)
+{
+	// The endpoint only takes a new report once the last one is out, so there's one in flight at most
+	armedEdge = pendingEdge;
+	armed = pending;
+	pending = false;
+}
+
+void input_latency_report_unchanged(void)
+{
+	pending = false; // The press didn't change the report (hidden by a hotkey, already held)
+}
+
+void input_latency_report_sent(void)
+{
+	if (!armed)
+		return;
+
+	armed = false;
+	uint8_t mode = get_input_mode();
+	if (mode >= INPUT_LATENCY_MODES)
+		return;
+
+	uint32_t micros = time_us_32() - armedEdge;
+	InputLatencyStats &stats = store.modes[mode];
+	if (micros > stats.maxMicros)
+		stats.maxMicros = micros;
+	stats.count++;
+	stats.bins[logBinFor(micros, INPUT_LATENCY_BINS)]++;
+}
+
+const InputLatencyStats *input_latency_get_stats(uint8_t mode)
+{
+	return mode < INPUT_LATENCY_MODES ? &store.modes[mode] : NULL;
+}
+
+uint32_t input_latency_percentile(const InputLatencyStats *stats, uint8_t percent)
+{
+	return logBinPercentile(stats->bins, INPUT_LATENCY_BINS, stats->count, percent);
+}
@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "sof_sync.h"
+
+#include "pico/time.h"
+#include "hardware/structs/usb.h"
+
+static SOFStats stats = { };
+static uint64_t sofMicros = 0;         // Estimated time of the most recent SOF
+static uint32_t goodFrames = 0;        // Consecutive frames inside SOF_LOCK_ERROR
+static bool locked = false;
+static bool inPhaseValid = false;
+static uint64_t sampleMicros = 0;      // Input sample time of the report being built
+static uint64_t armedSampleMicros = 0; // Input sample time of the report waiting on the IN endpoint
+static bool reportInFlight = false;
+static uint32_t intervalFrames = 1;    // Endpoint bInterval, the host polls once every this many frames
+
+// Start of the current polling period (the SOF of the frame the host polls in)
+static inline uint64_t sof_sync_period_start(void)
+{
+	return sofMicros - (uint64_t)(stats.frames % intervalFrames) * SOF_FRAME_MICROS;
+}
+
+static void sof_sync_unlock(void)
+{
+	if (locked)
+		stats.lockLosses++;
+
+	locked = false;
+	goodFrames = 0;
+	inPhaseValid = false; // Frame count no longer lines up with the host's polling period
+}
+
+void sof_sync_enable(void)
+{
+	// TinyUSB only unmasks the SOF interrupt for its own enumeration workaround
+	usb_hw_set->inte = USB_INTS_DEV_SOF_BITS;
+}
+
+void sof_sync_set_interval(uint8_t frames)
+{
+	intervalFrames = frames ? frames : 1;
+}
+
+void sof_sync_frame(void)
+{
+	uint64_t now = time_us_64();
+	stats.frames++;
+
+	if (sofMicros == 0)
+	{
+		sofMicros = now;
+		return;
+	}
+
+	// SOF events are deferred to tud_task(), so an observation can only ever be late.
+	// Track the earliest arrival: snap back on an early observation, otherwise creep forward 1us per frame.
+	uint64_t predicted = sofMicros + SOF_FRAME_MICROS;
+	int64_t error = (int64_t)(now - predicted);
+	if (error < -(SOF_FRAME_MICROS / 2) || error > (SOF_FRAME_MICROS / 2))
+	{
+		// Missed frames (long tud_task gap, suspend) so start over from this one
+		sofMicros = now;
+		sof_sync_unlock();
+		return;
+	}
+
+	uint32_t absError = (error < 0) ? -error : error;
+	stats.jitterMicros = (stats.jitterMicros * 15 + absError) / 16;
+	sofMicros = (error < 0) ? now : predicted + (error > 0);
+
+	if (absError > SOF_LOCK_ERROR)
+		sof_sync_unlock();
+	else if (++goodFrames >= SOF_LOCK_FRAMES)
+		locked = true;
+
+	if (locked)
+		stats.lockedFrames++;
+}
+
+void sof_sync_input_sampled(uint64_t sampledMicros)
+{
+	sampleMicros = sampledMicros;
+}
+
+void sof_sync_report_armed(void)
+{
+	armedSampleMicros = sampleMicros;
+	reportInFlight = true;
+}
+
+void sof_sync_report_sent(void)
+{
+	uint64_t now = time_us_64();
+	stats.reports++;
+
+	if (reportInFlight)
+	{
+		stats.lastAgeMicros = (uint32_t)(now - armedSampleMicros);
+		stats.avgAgeMicros = (stats.avgAgeMicros * 15 + stats.lastAgeMicros) / 16;
+		if (stats.lastAgeMicros > stats.maxAgeMicros)
+			stats.maxAgeMicros = stats.lastAgeMicros;
+
+		reportInFlight = false;
+	}
+
+	if (locked)
+	{
+		// Same earliest-arrival filter as the SOF phase, relative to the polling period start
+		uint32_t period = SOF_FRAME_MICROS * intervalFrames;
+		int64_t offset = (int64_t)(now - sof_sync_period_start()) % period;
+		if (offset < 0)
+			offset += period;
+
+		if (!inPhaseValid || offset < stats.inPhaseMicros)
+			stats.inPhaseMicros = offset;
+		else if (stats.inPhaseMicros < period - 1)
+			stats.inPhaseMicros++;
+
+		inPhaseValid = true;
+	}
+}
+
+bool sof_sync_locked(void)
+{
+	// Drop out if SOFs stopped arriving altogether (unplugged, suspended)
+	return locked && (time_us_64() - sofMicros) < (3 * SOF_FRAME_MICROS);
+}
+
+uint64_t sof_sync_next_deadline(uint64_t nowMicros, uint32_t leadMicros)
+{
+	uint32_t period = SOF_FRAME_MICROS * intervalFrames;
+	int64_t deadline = (int64_t)(sof_sync_period_start() + stats.inPhaseMicros) - leadMicros;
+	if (deadline <= (int64_t)nowMicros)
+		deadline += (((int64_t)nowMicros - deadline) / period + 1) * period;
+
+	return (uint64_t)deadline;
+}
+
+uint64_t sof_sync_next_frame(uint64_t nowMicros)
+{
+	if (nowMicros < sofMicros)
+		return sofMicros;
+
+	return sofMicros + ((nowMicros - sofMicros) / SOF_FRAME_MICROS + 1) * SOF_FRAME_MICROS;
+}
+
+const SOFStats *sof_sync_get_stats(void)
+{
+	return &stats;
+}
@@ -5,6 +5,8 @@
 
 #include <stdint.h>
 
+#include "pico/time.h"
+
 #include "tusb_config.h"
 #include "tusb.h"
 #include "class/hid/hid.h"
@@ -16,22 +18,39 @@
 #include "net_driver.h"
 #include "hid_driver.h"
 #include "xinput_driver.h"
+#include "sof_sync.h"
+#include "input_latency.h"
 
 UsbMode usb_mode = USB_MODE_HID;
 InputMode input_mode = INPUT_MODE_XINPUT;
+uint8_t poll_interval = 0;
+uint64_t reconnect_at = 0;
+static uint8_t previous_report[CFG_TUD_ENDPOINT0_SIZE] = { };
 
 InputMode get_input_mode(void)
 {
 	return input_mode;
 }
 
-void initialize_driver(InputMode mode)
+uint8_t get_poll_interval(void)
+{
+	return poll_interval;
+}
+
+void initialize_driver(InputMode mode, uint8_t pollInterval)
 {
 	input_mode = mode;
+	poll_interval = pollInterval;
 	if (mode == INPUT_MODE_CONFIG)
 		usb_mode = USB_MODE_NET;
 
 	tusb_init();
+
+	if (usb_mode == USB_MODE_HID)
+	{
+		sof_sync_enable();
+		sof_sync_set_interval(pollInterval ? pollInterval : 1);
+	}
 }
 
 void receive_report(uint8_t *buffer)
@@ -43,16 +62,38 @@ void receive_report(uint8_t *buffer)
 	}
 }
 
-void send_report(void *report, uint16_t report_size)
+bool switch_input_mode(InputMode mode)
 {
-	static uint8_t previous_report[CFG_TUD_ENDPOINT0_SIZE] = { };
+	if (usb_mode != USB_MODE_HID || mode == INPUT_MODE_CONFIG || mode == input_mode || reconnect_at != 0)
+		return false;
+
+	// Detach, then come back with the new descriptors once the host has noticed.
+	// The gamepad driver below follows input_mode, so the bus reset on reconnect brings up the new class.
+	tud_disconnect();
+	input_mode = mode;
+	memset(previous_report, 0, sizeof(previous_report));
+	reconnect_at = time_us_64() + USB_RECONNECT_MICROS;
+	return true;
+}
+
+void usb_driver_task(void)
+{
+	if (reconnect_at != 0 && time_us_64() >= reconnect_at)
+	{
+		reconnect_at = 0;
+		tud_connect();
+	}
+}
 
+bool send_report(void *report, uint16_t report_size)
+{
 	if (tud_suspended())
 		tud_remote_wakeup();
 
+	bool sent = true;
 	if (memcmp(previous_report, report, report_size) != 0)
 	{
-		bool sent = false;
+		sent = false;
 		switch (input_mode)
 		{
 			case INPUT_MODE_XINPUT:
@@ -65,31 +106,87 @@ void send_report(void *report, uint16_t report_size)
 		}
 
 		if (sent)
+		{
 			memcpy(previous_report, report, report_size);
+			sof_sync_report_armed();
+			input_latency_report_armed();
+		}
 	}
+	else
+	{
+		input_latency_report_unchanged();
+	}
+
+	return sent;
 }
 
 /* USB Driver Callback (Required for XInput) */
 
+// TinyUSB only asks for the app driver once, so gamepad modes go through this forwarding driver
+static inline const usbd_class_driver_t *gamepad_driver(void)
+{
+	return (input_mode == INPUT_MODE_XINPUT) ? &xinput_driver : &hid_driver;
+}
+
+static void gamepad_init(void)
+{
+	xinput_driver.init();
+	hid_driver.init();
+}
+
+static void gamepad_reset(uint8_t rhport)
+{
+	// Reset both, the one we switched away from may still hold endpoint state
+	xinput_driver.reset(rhport);
+	hid_driver.reset(rhport);
+}
+
+static uint16_t gamepad_open(uint8_t rhport, tusb_desc_interface_t const *itf_desc, uint16_t max_len)
+{
+	return gamepad_driver()->open(rhport, itf_desc, max_len);
+}
+
+static bool gamepad_control_request(uint8_t rhport, tusb_control_request_t const *request)
+{
+	return gamepad_driver()->control_request(rhport, request);
+}
+
+static bool gamepad_control_complete(uint8_t rhport, tusb_control_request_t const *request)
+{
+	return gamepad_driver()->control_complete(rhport, request);
+}
+
+static bool gamepad_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+	return gamepad_driver()->xfer_cb(rhport, ep_addr, result, xferred_bytes);
+}
+
+static void gamepad_sof(uint8_t rhport)
+{
+	gamepad_driver()->sof(rhport);
+}
+
+static const usbd_class_driver_t gamepad_class_driver = {
+#if CFG_TUSB_DEBUG >= 2
+	.name = "GAMEPAD",
+#endif
+	.init = gamepad_init,
+	.reset = gamepad_reset,
+	.open = gamepad_open,
+	.control_request = gamepad_control_request,
+	.control_complete = gamepad_control_complete,
+	.xfer_cb = gamepad_xfer_cb,
+	.sof = gamepad_sof
+};
+
 const usbd_class_driver_t *usbd_app_driver_get_cb(uint8_t *driver_count)
 {
 	*driver_count = 1;
 
 	if (usb_mode == USB_MODE_NET)
-	{
 		return &net_driver;
-	}
 	else
-	{
-		switch (input_mode)
-		{
-			case INPUT_MODE_XINPUT:
-				return &xinput_driver;
-
-			default:
-				return &hid_driver;
-		}
-	}
+		return &gamepad_class_driver;
 }
 
 /* USB HID Callbacks (Required) */
@@ -140,6 +237,9 @@ void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t rep
 // Invoked when device is mounted
 void tud_mount_cb(void)
 {
+	// A bus reset (e.g. after an input mode switch) can leave the SOF interrupt masked again
+	if (usb_mode == USB_MODE_HID)
+		sof_sync_enable();
 }
 
 // Invoked when device is unmounted
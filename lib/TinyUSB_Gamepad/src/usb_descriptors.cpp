@@ -10,6 +10,30 @@
 #include "GamepadDescriptors.h"
 #include "webserver_descriptors.h"
 
+static uint8_t configuration_descriptor[128];
+
+// Copy a configuration descriptor with every interrupt endpoint's bInterval set to the selected poll interval
+static uint8_t const *apply_poll_interval(uint8_t const *descriptor)
+{
+	uint8_t interval = get_poll_interval();
+	uint16_t total = tu_le16toh(((tusb_desc_configuration_t const *)descriptor)->wTotalLength);
+	if (interval == 0 || total > sizeof(configuration_descriptor))
+		return descriptor;
+
+	memcpy(configuration_descriptor, descriptor, total);
+	for (uint8_t *p = configuration_descriptor; p < configuration_descriptor + total; p += tu_desc_len(p))
+	{
+		if (tu_desc_type(p) != TUSB_DESC_ENDPOINT)
+			continue;
+
+		tusb_desc_endpoint_t *endpoint = (tusb_desc_endpoint_t *)p;
+		if (endpoint->bmAttributes.xfer == TUSB_XFER_INTERRUPT)
+			endpoint->bInterval = interval;
+	}
+
+	return configuration_descriptor;
+}
+
 // Invoked when received GET STRING DESCRIPTOR request
 // Application return pointer to descriptor, whose contents must exist long enough for transfer to complete
 uint16_t const *tud_descriptor_string_cb(uint8_t index, uint16_t langid)
@@ -74,12 +98,12 @@ uint8_t const *tud_descriptor_configuration_cb(uint8_t index)
 			return net_configuration_arr[index];
 
 		case INPUT_MODE_XINPUT:
-			return xinput_configuration_descriptor;
+			return apply_poll_interval(xinput_configuration_descriptor);
 
 		case INPUT_MODE_SWITCH:
-			return switch_configuration_descriptor;
+			return apply_poll_interval(switch_configuration_descriptor);
 
 		default:
-			return hid_configuration_descriptor;
+			return apply_poll_interval(hid_configuration_descriptor);
 	}
 }
@@ -4,6 +4,8 @@
  */
 
 #include "xinput_driver.h"
+#include "sof_sync.h"
+#include "input_latency.h"
 
 uint8_t endpoint_in = 0;
 uint8_t endpoint_out = 0;
@@ -100,10 +102,22 @@ static bool xinput_xfer_callback(uint8_t rhport, uint8_t ep_addr, xfer_result_t
 
 	if (ep_addr == endpoint_out)
 		usbd_edpt_xfer(0, endpoint_out, xinput_out_buffer, XINPUT_OUT_SIZE);
+	else if (ep_addr == endpoint_in)
+	{
+		sof_sync_report_sent();
+		input_latency_report_sent();
+	}
 
 	return true;
 }
 
+static void xinput_sof(uint8_t rhport)
+{
+	(void)rhport;
+
+	sof_sync_frame();
+}
+
 const usbd_class_driver_t xinput_driver =
 {
 #if CFG_TUSB_DEBUG >= 2
@@ -115,5 +129,5 @@ const usbd_class_driver_t xinput_driver =
 	.control_request = xinput_device_control_request,
 	.control_complete = xinput_control_complete,
 	.xfer_cb = xinput_xfer_callback,
-	.sof = NULL
+	.sof = xinput_sof
 };
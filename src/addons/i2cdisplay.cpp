@@ -31,19 +31,44 @@ void I2CDisplayAddon::setup() {
 	obdSetContrast(&obd, 0xFF);
 	obdSetBackBuffer(&obd, ucBackBuffer);
 	clearScreen(1);
+	drawnVersion = 0;
+	drawnGamepad = false;
+	dumpPage = 0;
+	dirtyPages = 0;
 }
 
 void I2CDisplayAddon::process() {
+	// The gamepad screen only changes with the input snapshot, skip the redraw while it's the same.
+	// The splash and config screens are redrawn once the previous frame has gone out.
+	bool configMode = Storage::getInstance().GetConfigMode();
+	bool splash = getMillis() < 7500 && SPLASH_MODE != NOSPLASH;
+	uint32_t version = Storage::getInstance().GetSnapshotVersion();
+	bool gamepadScreen = !configMode && !splash;
+	if (gamepadScreen ? (!drawnGamepad || version != drawnVersion) : dirtyPages == 0) {
+		drawnGamepad = gamepadScreen;
+		drawnVersion = version;
+		drawScreen(configMode, splash);
+		dirtyPages = obd.height >> 3;
+	}
+
+	// A whole frame is ~15ms of blocking I2C at 800kHz, send it a page at a time so the LEDs get a turn in between.
+	// Pages go out round-robin from where the last pass stopped, so a frame redrawn mid-dump still lands everywhere.
+	for (int i = 0; i < DISPLAY_PAGES_PER_PASS && dirtyPages > 0; i++, dirtyPages--) {
+		obdDumpPages(&obd, NULL, dumpPage, 1);
+		dumpPage = (dumpPage + 1) % (obd.height >> 3);
+	}
+}
+
+void I2CDisplayAddon::drawScreen(bool configMode, bool splash) {
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
 	Gamepad * pGamepad = Storage::getInstance().GetProcessedGamepad();
 
 	clearScreen(0);
-	bool configMode = Storage::getInstance().GetConfigMode();
 	if (configMode == true ) {
 		drawStatusBar(gamepad);
 		drawText(0, 3, "[Web Config Mode]");
 		drawText(0, 4, std::string("GP2040-CE : ") + std::string(GP2040VERSION));
-	} else if (getMillis() < 7500 && SPLASH_MODE != NOSPLASH) {
+	} else if (splash) {
 		drawSplashScreen(SPLASH_MODE, 90);
 	} else {
 		drawStatusBar(gamepad);
@@ -111,8 +136,6 @@ void I2CDisplayAddon::process() {
 				break;
 		}
 	}
-
-	obdDumpBuffer(&obd, NULL);
 }
 
 void I2CDisplayAddon::clearScreen(int render) {
@@ -473,6 +496,9 @@ void I2CDisplayAddon::drawStatusBar(Gamepad * gamepad)
 		case SOCD_MODE_NEUTRAL:               statusBar += " SOCD-N"; break;
 		case SOCD_MODE_UP_PRIORITY:           statusBar += " SOCD-U"; break;
 		case SOCD_MODE_SECOND_INPUT_PRIORITY: statusBar += " SOCD-L"; break;
+		case SOCD_MODE_FIRST_INPUT_PRIORITY:  statusBar += " SOCD-F"; break;
+		case SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL:      statusBar += " SOCD-UL"; break;
+		case SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL: statusBar += " SOCD-LN"; break;
 	}
 	drawText(0, 0, statusBar);
 }
@@ -105,18 +105,42 @@ void NeoPicoLEDAddon::setup()
 	neopico = new NeoPico(-1, 0);
 	configureLEDs();
 
-	nextRunTime = make_timeout_time_ms(0); // Reset timeout
+	memset(featureData, 0, sizeof(featureData));
+	hotkeyAction = HOTKEY_LEDS_NONE;
+	EventBus &eventBus = EventBus::getInstance();
+	eventBus.subscribe(EVENT_HOTKEY, this);
+	eventBus.subscribe(EVENT_USB_OUT_REPORT, this);
+	eventBus.subscribe(EVENT_LED_OPTIONS, this);
+}
+
+void NeoPicoLEDAddon::handleEvent(const GamepadEvent &event)
+{
+	switch (event.type)
+	{
+		case EVENT_HOTKEY:
+			if (event.hotkey.type == HOTKEY_ACTION_LEDS)
+				hotkeyAction = (AnimationHotkey)event.hotkey.param;
+			break;
+
+		case EVENT_USB_OUT_REPORT:
+			memcpy(featureData, event.data, sizeof(featureData));
+			break;
+
+		case EVENT_LED_OPTIONS:
+			configureLEDs();
+			break;
+	}
 }
 
 void NeoPicoLEDAddon::process()
 {
 	LEDOptions ledOptions = Storage::getInstance().getLEDOptions();
-	if (ledOptions.dataPin < 0 || !time_reached(this->nextRunTime))
+	if (ledOptions.dataPin < 0)
 		return;
 
 	Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
-	uint8_t * featureData = Storage::getInstance().GetFeatureData();
-	AnimationHotkey action = animationHotkeys(gamepad);
+	AnimationHotkey action = hotkeyAction;
+	hotkeyAction = HOTKEY_LEDS_NONE;
 	if (PLED_TYPE == PLED_TYPE_RGB) {
 		inputMode = gamepad->options.inputMode; // HACK
 		switch (gamepad->options.inputMode) {
@@ -164,8 +188,6 @@ void NeoPicoLEDAddon::process()
 	neopico->SetFrame(frame);
 	neopico->Show();
 	AnimationStore.save();
-
-	this->nextRunTime = make_timeout_time_ms(NeoPicoLEDAddon::intervalMS);
 }
 
 std::vector<uint8_t> * NeoPicoLEDAddon::getLEDPositions(string button, std::vector<std::vector<uint8_t>> *positions)
@@ -406,54 +428,3 @@ void NeoPicoLEDAddon::configureLEDs()
 	as.SetMode(as.options.baseAnimationIndex);
 	as.SetMatrix(matrix);
 }
-
-AnimationHotkey animationHotkeys(Gamepad *gamepad)
-{
-	AnimationHotkey action = HOTKEY_LEDS_NONE;
-
-	if (gamepad->pressedF1())
-	{
-		if (gamepad->pressedB3())
-		{
-			action = HOTKEY_LEDS_ANIMATION_UP;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_B3 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedB1())
-		{
-			action = HOTKEY_LEDS_ANIMATION_DOWN;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_B1 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedB4())
-		{
-			action = HOTKEY_LEDS_BRIGHTNESS_UP;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_B4 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedB2())
-		{
-			action = HOTKEY_LEDS_BRIGHTNESS_DOWN;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_B2 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedR1())
-		{
-			action = HOTKEY_LEDS_PARAMETER_UP;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_R1 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedR2())
-		{
-			action = HOTKEY_LEDS_PARAMETER_DOWN;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_R2 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedL1())
-		{
-			action = HOTKEY_LEDS_PRESS_PARAMETER_UP;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_L1 | gamepad->f1Mask);
-		}
-		else if (gamepad->pressedL2())
-		{
-			action = HOTKEY_LEDS_PRESS_PARAMETER_DOWN;
-			gamepad->state.buttons &= ~(GAMEPAD_MASK_L2 | gamepad->f1Mask);
-		}
-	}
-
-	return action;
-}
@@ -95,6 +95,15 @@ void PlayerLEDAddon::setup() {
 
 	if (pwmLEDs != nullptr)
 		pwmLEDs->setup();
+
+	memset(featureData, 0, sizeof(featureData));
+	EventBus::getInstance().subscribe(EVENT_USB_OUT_REPORT, this);
+}
+
+void PlayerLEDAddon::handleEvent(const GamepadEvent &event)
+{
+	if (event.type == EVENT_USB_OUT_REPORT)
+		memcpy(featureData, event.data, sizeof(featureData));
 }
 
 void PlayerLEDAddon::process()
@@ -102,7 +111,6 @@ void PlayerLEDAddon::process()
 	Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
 
 	// Player LEDs can be PWM or driven by NeoPixel
-	uint8_t * featureData = Storage::getInstance().GetFeatureData();
 	if (PLED_TYPE == PLED_TYPE_PWM) { // only process the feature queue if we're on PWM
 		if (pwmLEDs != nullptr)
 			pwmLEDs->display();
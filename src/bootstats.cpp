@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "bootstats.h"
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+
+static const char * const bootStageNames[BOOT_STAGE_COUNT] =
+{
+	"main",
+	"storage",
+	"gamepad",
+	"usbInit",
+	"inputs",
+	"usbMounted",
+	"firstReport",
+	"auxStart",
+	"auxReady",
+};
+
+// Left alone by the C runtime at startup, so it outlives a watchdog reboot (but not a power cycle)
+static BootStatsStore __uninitialized_ram(bootStatsStore);
+
+BootStats::BootStats() : current{}, record(&current), store(bootStatsStore)
+{
+	current.fastBoot = GAMEPAD_FAST_BOOT != 0;
+}
+
+void BootStats::setup(bool gamepadMode)
+{
+	if (!gamepadMode)
+		return;
+
+	// The stages so far were marked before the mode was known, carry them over and record the rest in place
+	store.magic = 0;
+	memcpy(&store.last, &current, sizeof(BootRecord));
+	store.magic = BOOT_STATS_MAGIC;
+	record = &store.last;
+}
+
+void BootStats::mark(BootStage stage)
+{
+	if (record->stages[stage] == 0)
+		record->stages[stage] = time_us_32();
+}
+
+void BootStats::addonSetup(const std::string &name, uint32_t micros)
+{
+	uint8_t core = get_core_num();
+	uint8_t count = record->addonCount[core];
+	if (count >= BOOT_MAX_ADDONS)
+		return;
+
+	BootAddonTime &addon = record->addons[core][count];
+	strncpy(addon.name, name.c_str(), BOOT_ADDON_NAME_SIZE - 1);
+	addon.name[BOOT_ADDON_NAME_SIZE - 1] = 0;
+	addon.micros = micros;
+	__dmb(); // Entry must be complete before the web config (other core) can see it
+	record->addonCount[core] = count + 1;
+}
+
+const BootRecord * BootStats::lastGamepadBoot()
+{
+	return store.magic == BOOT_STATS_MAGIC ? &store.last : nullptr;
+}
+
+const char * BootStats::stageName(BootStage stage)
+{
+	return bootStageNames[stage];
+}
@@ -1,6 +1,6 @@
 #include "configmanager.h"
 #include "configs/webconfig.h"
-#include "addons/neopicoleds.h"
+#include "eventbus.h"
 
 void ConfigManager::setup(ConfigType config) {
 	switch(config) {
@@ -27,14 +27,10 @@ void ConfigManager::setGamepadOptions(Gamepad* gamepad) {
 void ConfigManager::setLedOptions(LEDOptions ledOptions) {
 	Storage::getInstance().setLEDOptions(ledOptions);
 
-    // Configure LEDs in the neopico
-	for (std::vector<GPAddon*>::iterator it = Storage::getInstance().Addons.begin(); it != Storage::getInstance().Addons.end(); it++) {
-		if ((*it)->name() == NeoPicoLEDName) {
-			NeoPicoLEDAddon * neopicoled = (NeoPicoLEDAddon*)(*it);
-			neopicoled->configureLEDs();
-			break; // trigger LED configuration
-		}
-	} 
+	// The LED addon reconfigures itself on core1
+	GamepadEvent event;
+	event.type = EVENT_LED_OPTIONS;
+	EventBus::getInstance().publish(event);
 }
 
 void ConfigManager::setBoardOptions(BoardOptions boardOptions) {
@@ -59,6 +55,7 @@ void ConfigManager::setBoardOptions(BoardOptions boardOptions) {
 	gamepad->mapButtonR3->setPin(boardOptions.pinButtonR3);
 	gamepad->mapButtonA1->setPin(boardOptions.pinButtonA1);
 	gamepad->mapButtonA2->setPin(boardOptions.pinButtonA2);
+	gamepad->updateMappings();
 
 	GamepadStore.save();
 }
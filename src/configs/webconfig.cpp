@@ -2,11 +2,19 @@
 
 #include "storagemanager.h"
 #include "configmanager.h"
+#include "bootstats.h"
+#include "perfstats.h"
+#include "inputtrace.h"
+#include "input_latency.h"
+#include "switchstats.h"
+#include "scheduler.h"
 
 #include <cstring>
 #include <string>
 #include <vector>
 
+#include "hardware/clocks.h"
+
 // HTTPD Includes
 #include <ArduinoJson.h>
 #include "rndis/rndis.h"
@@ -31,6 +39,16 @@
 #define API_SET_PIN_MAPPINGS "/api/setPinMappings"
 #define API_GET_ADDON_OPTIONS "/api/getAddonsOptions"
 #define API_SET_ADDON_OPTIONS "/api/setAddonsOptions"
+#define API_GET_DEBOUNCE_OPTIONS "/api/getDebounceOptions"
+#define API_SET_DEBOUNCE_OPTIONS "/api/setDebounceOptions"
+#define API_GET_REMAP_OPTIONS "/api/getRemapOptions"
+#define API_SET_REMAP_OPTIONS "/api/setRemapOptions"
+#define API_GET_PERF_STATS "/api/getPerfStats"
+#define API_GET_BOOT_STATS "/api/getBootStats"
+#define API_GET_SCHEDULER_STATS "/api/getSchedulerStats"
+#define API_GET_INPUT_TRACE "/api/getInputTrace"
+#define API_GET_LATENCY_STATS "/api/getLatencyStats"
+#define API_GET_SWITCH_STATS "/api/getSwitchStats"
 
 #define LWIP_HTTPD_POST_MAX_URI_LEN 128
 #define LWIP_HTTPD_POST_MAX_PAYLOAD_LEN 2048
@@ -39,7 +57,7 @@ using namespace std;
 
 extern struct fsdata_file file__index_html[];
 
-const static vector<string> spaPaths = { "/display-config", "/led-config", "/pin-mapping", "/settings", "/reset-settings", "/add-ons" };
+const static vector<string> spaPaths = { "/display-config", "/led-config", "/pin-mapping", "/settings", "/reset-settings", "/add-ons", "/switch-stats" };
 const static vector<string> excludePaths = { "/css", "/images", "/js", "/static" };
 static char *http_post_uri;
 static char http_post_payload[LWIP_HTTPD_POST_MAX_PAYLOAD_LEN];
@@ -155,6 +173,14 @@ std::string serialize_json(DynamicJsonDocument &doc)
 	return data;
 }
 
+// Response to a rejected POST, nothing was saved
+std::string serialize_error(const char *message)
+{
+	DynamicJsonDocument doc(128);
+	doc["error"] = message;
+	return serialize_json(doc);
+}
+
 std::string setDisplayOptions()
 {
 	DynamicJsonDocument doc = get_post_data();
@@ -208,14 +234,32 @@ std::string getDisplayOptions() // Manually set Document Attributes for the disp
 	return serialize_json(doc);
 }
 
+// USB poll intervals in ms the web configurator offers, 0 = input mode default
+static const uint8_t pollIntervals[] = { 0, 1, 2, 4, 8 };
+
 std::string setGamepadOptions()
 {
 	DynamicJsonDocument doc = get_post_data();
+
+	// bInterval, and the input loop and macro periods derived from it, only take the web configurator's choices
+	bool validPollInterval = false;
+	if (doc["pollInterval"].is<uint8_t>())
+	{
+		for (uint8_t pollInterval : pollIntervals)
+			validPollInterval |= (doc["pollInterval"].as<uint8_t>() == pollInterval);
+	}
+	if (!validPollInterval)
+		return serialize_error("pollInterval must be 0, 1, 2, 4 or 8");
+
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
 	gamepad->options.dpadMode  = doc["dpadMode"];
 	gamepad->options.inputMode = doc["inputMode"];
 	gamepad->options.socdMode  = doc["socdMode"];
 	ConfigManager::getInstance().setGamepadOptions(gamepad);
+
+	BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
+	boardOptions.pollInterval  = doc["pollInterval"];
+	Storage::getInstance().setBoardOptions(boardOptions);
 	return serialize_json(doc);
 }
 
@@ -226,6 +270,7 @@ std::string getGamepadOptions()
 	doc["dpadMode"]  = options.dpadMode;
 	doc["inputMode"] = options.inputMode;
 	doc["socdMode"]  = options.socdMode;
+	doc["pollInterval"] = Storage::getInstance().getBoardOptions().pollInterval;
 	return serialize_json(doc);
 }
 
@@ -430,6 +475,279 @@ std::string getAddonOptions()
 	return serialize_json(doc);
 }
 
+// Same order as Gamepad::gamepadMappings (BoardOptions::debounceMicros, remapProfiles)
+static const char * const buttonNames[GAMEPAD_DIGITAL_INPUT_COUNT] =
+{
+	"Up", "Down", "Left", "Right",
+	"B1", "B2", "B3", "B4",
+	"L1", "R1", "L2", "R2",
+	"S1", "S2", "L3", "R3",
+	"A1", "A2",
+};
+
+std::string setDebounceOptions()
+{
+	DynamicJsonDocument doc = get_post_data();
+
+	// Debouncer::setMode() would take anything unknown as symmetric, windows have to fit BoardOptions
+	if (!doc["mode"].is<uint8_t>() || doc["mode"].as<uint8_t>() >= DEBOUNCE_MODE_COUNT)
+		return serialize_error("mode must be a DebounceMode value");
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		if (doc["windows"].containsKey(buttonNames[i]) && !doc["windows"][buttonNames[i]].is<uint16_t>())
+			return serialize_error("windows must be integers from 0 to 65535");
+	}
+
+	BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
+	boardOptions.hasBoardOptions = true;
+	boardOptions.debounceMode = doc["mode"];
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		if (doc["windows"].containsKey(buttonNames[i]))
+			boardOptions.debounceMicros[i] = doc["windows"][buttonNames[i]];
+	}
+
+	// Through ConfigManager so the new windows apply without a reboot
+	ConfigManager::getInstance().setBoardOptions(boardOptions);
+
+	return serialize_json(doc);
+}
+
+std::string getDebounceOptions()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	const BoardOptions &boardOptions = Storage::getInstance().getBoardOptionsRef();
+	doc["mode"] = boardOptions.debounceMode;
+
+	auto windows = doc.createNestedObject("windows"); // Microseconds, per button
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		windows[buttonNames[i]] = boardOptions.debounceMicros[i];
+
+	return serialize_json(doc);
+}
+
+// Per button, lifetime counters plus bounce times since power-on in microseconds
+std::string getSwitchStats()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN * 2);
+	const BoardOptions &boardOptions = Storage::getInstance().getBoardOptionsRef();
+	Gamepad *gamepad = Storage::getInstance().GetGamepad();
+	doc["bounceWindow"] = GAMEPAD_BOUNCE_WINDOW_MICROS;
+
+	auto buttons = doc.createNestedArray("buttons");
+	for (int i = 0; GAMEPAD_SWITCH_STATS && i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		uint8_t pin = gamepad->gamepadMappings[i]->pin;
+		if (pin >= NUM_BANK0_GPIOS)
+			continue;
+
+		SwitchStats &switchStats = SwitchStats::getInstance();
+		const SwitchPinStats &stats = switchStats.getPin(pin);
+		auto entry = buttons.createNestedObject();
+		entry["name"]       = buttonNames[i];
+		entry["pin"]        = pin;
+		entry["actuations"] = stats.counters.actuations;
+		entry["bounces"]    = stats.counters.bounces;
+		entry["chatters"]   = stats.counters.chatters;
+		entry["p50"]        = switchStats.percentile(pin, 50);
+		entry["p99"]        = switchStats.percentile(pin, 99);
+		entry["max"]        = stats.maxBounceMicros;
+		entry["window"]     = boardOptions.debounceMicros[i];
+		// Longest bounce seen plus a quarter, rounded up to 100us. Nothing to go on until one is seen.
+		entry["suggested"]  = stats.maxBounceMicros ? ((stats.maxBounceMicros * 5 / 4 + 99) / 100) * 100 : 0;
+	}
+
+	return serialize_json(doc);
+}
+
+std::string setRemapOptions()
+{
+	DynamicJsonDocument doc = get_post_data();
+
+	BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
+	boardOptions.hasBoardOptions = true;
+	boardOptions.remapProfile = doc["profile"];
+	if (boardOptions.remapProfile >= GAMEPAD_REMAP_PROFILES)
+		boardOptions.remapProfile = 0;
+
+	for (int profile = 0; profile < GAMEPAD_REMAP_PROFILES; profile++)
+	{
+		JsonObject remap = doc["profiles"][profile];
+		if (remap.isNull())
+			continue;
+
+		for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		{
+			if (!remap.containsKey(buttonNames[i]))
+				continue;
+
+			const char *target = remap[buttonNames[i]];
+			uint8_t value = GAMEPAD_REMAP_NONE; // null or unknown name sends nothing
+			for (int j = 0; target != nullptr && j < GAMEPAD_DIGITAL_INPUT_COUNT; j++)
+			{
+				if (!strcmp(target, buttonNames[j]))
+					value = j;
+			}
+			boardOptions.remapProfiles[profile][i] = value;
+		}
+	}
+
+	// Through ConfigManager so the profiles apply without a reboot
+	ConfigManager::getInstance().setBoardOptions(boardOptions);
+
+	return serialize_json(doc);
+}
+
+std::string getRemapOptions()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	const BoardOptions &boardOptions = Storage::getInstance().getBoardOptionsRef();
+	doc["profile"] = boardOptions.remapProfile;
+
+	auto profiles = doc.createNestedArray("profiles"); // Button each input sends, null for none
+	for (int profile = 0; profile < GAMEPAD_REMAP_PROFILES; profile++)
+	{
+		auto remap = profiles.createNestedObject();
+		for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		{
+			uint8_t target = boardOptions.remapProfiles[profile][i];
+			if (target < GAMEPAD_DIGITAL_INPUT_COUNT)
+				remap[buttonNames[i]] = buttonNames[target];
+			else
+				remap[buttonNames[i]] = nullptr;
+		}
+	}
+
+	return serialize_json(doc);
+}
+
+std::string getPerfStats()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN * 2);
+	float cyclesPerMicro = clock_get_hz(clk_sys) / 1000000.0f;
+	doc["enabled"] = GAMEPAD_PERF_STATS != 0;
+	doc["cyclesPerMicro"] = cyclesPerMicro;
+
+	auto stages = doc.createNestedArray("stages");
+	PerfStats &perfStats = PerfStats::getInstance();
+	for (uint8_t i = 0; i < perfStats.getStageCount(); i++)
+	{
+		const PerfStageStats &stats = perfStats.getStage(i);
+		auto stage = stages.createNestedObject();
+		stage["name"]  = stats.name;
+		stage["count"] = stats.count;
+		stage["min"]   = stats.count ? stats.minCycles / cyclesPerMicro : 0;
+		stage["avg"]   = stats.count ? (stats.totalCycles / stats.count) / cyclesPerMicro : 0;
+		stage["max"]   = stats.maxCycles / cyclesPerMicro;
+		stage["p99"]   = stats.percentile(99) / cyclesPerMicro;
+	}
+
+	return serialize_json(doc);
+}
+
+// The last gamepad-mode boot if one was kept through the reboot into web config, else this one
+std::string getBootStats()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	BootStats &bootStats = BootStats::getInstance();
+	const BootRecord *record = bootStats.lastGamepadBoot();
+	doc["gamepadMode"] = record != nullptr;
+	if (record == nullptr)
+		record = &bootStats.currentBoot();
+	doc["fastBoot"] = record->fastBoot;
+
+	auto stages = doc.createNestedObject("stages"); // Microseconds since power-on, 0 if not reached
+	for (uint8_t i = 0; i < BOOT_STAGE_COUNT; i++)
+		stages[BootStats::stageName((BootStage)i)] = record->stages[i];
+
+	auto addons = doc.createNestedArray("addons"); // Setup time of each addon
+	for (uint8_t core = 0; core < 2; core++)
+	{
+		for (uint8_t i = 0; i < record->addonCount[core] && i < BOOT_MAX_ADDONS; i++)
+		{
+			const BootAddonTime &addonTime = record->addons[core][i];
+			auto addon = addons.createNestedObject();
+			addon["name"]   = addonTime.name;
+			addon["core"]   = core;
+			addon["micros"] = addonTime.micros;
+		}
+	}
+
+	return serialize_json(doc);
+}
+
+// Press to IN transfer complete, per input mode, in microseconds
+std::string getLatencyStats()
+{
+	const static struct { InputMode mode; const char *name; } modes[] =
+	{
+		{ INPUT_MODE_XINPUT, "xinput" },
+		{ INPUT_MODE_SWITCH, "switch" },
+		{ INPUT_MODE_HID,    "hid" },
+	};
+
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	auto entries = doc.createNestedArray("modes");
+	for (auto &mode : modes)
+	{
+		const InputLatencyStats *stats = input_latency_get_stats(mode.mode);
+		if (stats == NULL)
+			continue;
+
+		auto entry = entries.createNestedObject();
+		entry["name"]  = mode.name;
+		entry["count"] = stats->count;
+		entry["p50"]   = input_latency_percentile(stats, 50);
+		entry["p99"]   = input_latency_percentile(stats, 99);
+		entry["max"]   = stats->maxMicros;
+	}
+
+	return serialize_json(doc);
+}
+
+// Binary, an InputTraceHeader then the records oldest first
+std::string getInputTrace()
+{
+	InputTrace &inputTrace = InputTrace::getInstance();
+	InputTraceHeader header;
+	header.magic = INPUT_TRACE_MAGIC;
+	header.version = INPUT_TRACE_VERSION;
+	header.recordSize = sizeof(InputTraceRecord);
+	header.count = GAMEPAD_INPUT_TRACE ? inputTrace.getCount() : 0;
+	header.captured = GAMEPAD_INPUT_TRACE ? inputTrace.getCaptured() : 0;
+
+	string data((const char *)&header, sizeof(header));
+	data.reserve(sizeof(header) + header.count * sizeof(InputTraceRecord));
+	for (uint32_t i = 0; i < header.count; i++)
+		data.append((const char *)&inputTrace.getRecord(i), sizeof(InputTraceRecord));
+
+	return data;
+}
+
+std::string getSchedulerStats()
+{
+	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	Scheduler &scheduler = Scheduler::getInstance();
+
+	auto tasks = doc.createNestedArray("tasks"); // Core1 addons, times in microseconds
+	for (uint8_t i = 0; i < scheduler.getTaskCount(); i++)
+	{
+		const SchedulerTask &task = scheduler.getTask(i);
+		auto entry = tasks.createNestedObject();
+		entry["name"]     = task.addon->name();
+		entry["period"]   = task.schedule.periodMicros;
+		entry["priority"] = task.schedule.priority;
+		entry["budget"]   = task.schedule.budgetMicros;
+		entry["runs"]     = task.runs;
+		entry["avg"]      = task.runs ? (uint32_t)(task.totalMicros / task.runs) : 0;
+		entry["max"]      = task.maxMicros;
+		entry["misses"]   = task.misses;
+		entry["overruns"] = task.overruns;
+	}
+
+	return serialize_json(doc);
+}
+
 // This should be a storage feature
 std::string resetSettings()
 {
@@ -453,6 +771,10 @@ int fs_open_custom(struct fs_file *file, const char *name)
 			return set_file_data(file, setPinMappings());
 		if (!memcmp(http_post_uri, API_SET_ADDON_OPTIONS, sizeof(API_SET_ADDON_OPTIONS)))
 			return set_file_data(file, setAddonOptions());
+		if (!memcmp(http_post_uri, API_SET_DEBOUNCE_OPTIONS, sizeof(API_SET_DEBOUNCE_OPTIONS)))
+			return set_file_data(file, setDebounceOptions());
+		if (!memcmp(http_post_uri, API_SET_REMAP_OPTIONS, sizeof(API_SET_REMAP_OPTIONS)))
+			return set_file_data(file, setRemapOptions());
 	}
 	else
 	{
@@ -466,6 +788,22 @@ int fs_open_custom(struct fs_file *file, const char *name)
 			return set_file_data(file, getPinMappings());
 		if (!memcmp(name, API_GET_ADDON_OPTIONS, sizeof(API_GET_ADDON_OPTIONS)))
 			return set_file_data(file, getAddonOptions());
+		if (!memcmp(name, API_GET_DEBOUNCE_OPTIONS, sizeof(API_GET_DEBOUNCE_OPTIONS)))
+			return set_file_data(file, getDebounceOptions());
+		if (!memcmp(name, API_GET_REMAP_OPTIONS, sizeof(API_GET_REMAP_OPTIONS)))
+			return set_file_data(file, getRemapOptions());
+		if (!memcmp(name, API_GET_PERF_STATS, sizeof(API_GET_PERF_STATS)))
+			return set_file_data(file, getPerfStats());
+		if (!memcmp(name, API_GET_BOOT_STATS, sizeof(API_GET_BOOT_STATS)))
+			return set_file_data(file, getBootStats());
+		if (!memcmp(name, API_GET_SCHEDULER_STATS, sizeof(API_GET_SCHEDULER_STATS)))
+			return set_file_data(file, getSchedulerStats());
+		if (!memcmp(name, API_GET_INPUT_TRACE, sizeof(API_GET_INPUT_TRACE)))
+			return set_file_data(file, getInputTrace());
+		if (!memcmp(name, API_GET_LATENCY_STATS, sizeof(API_GET_LATENCY_STATS)))
+			return set_file_data(file, getLatencyStats());
+		if (!memcmp(name, API_GET_SWITCH_STATS, sizeof(API_GET_SWITCH_STATS)))
+			return set_file_data(file, getSwitchStats());
 		if (!memcmp(name, API_RESET_SETTINGS, sizeof(API_RESET_SETTINGS)))
 			return set_file_data(file, resetSettings());
 	}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "debouncer.h"
+
+#include <string.h>
+
+Debouncer::Debouncer() : debounced(0), pressed(0), pressMicros(0), mode(GAMEPAD_DEBOUNCE_MODE), pinMask(0), lastRaw(0)
+{
+	memset(rawChangedAt, 0, sizeof(rawChangedAt));
+	memset(acceptedAt, 0, sizeof(acceptedAt));
+	for (int pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+		windows[pin] = GAMEPAD_DEBOUNCE_MICROS;
+}
+
+void Debouncer::setMode(DebounceMode newMode)
+{
+	mode = newMode;
+	if (mode == DEBOUNCE_MODE_VERTICAL)
+		GpioSampler::getInstance().start();
+	else
+		GpioSampler::getInstance().stop(); // Its alarm IRQ would cut every sleep short for nothing
+}
+
+void Debouncer::setWindow(uint8_t pin, uint32_t micros)
+{
+	if (pin < NUM_BANK0_GPIOS)
+		windows[pin] = micros;
+}
+
+uint32_t Debouncer::process(uint32_t raw, uint32_t nowMicros, const uint32_t *changeMicros)
+{
+	for (uint32_t changed = raw ^ lastRaw; changed; changed &= changed - 1)
+		rawChangedAt[__builtin_ctz(changed)] = nowMicros;
+	lastRaw = raw;
+	pressed = 0;
+
+	const uint32_t *changedAt = changeMicros ? changeMicros : rawChangedAt;
+	if (mode == DEBOUNCE_MODE_DISABLED || mode == DEBOUNCE_MODE_VERTICAL)
+	{
+		uint32_t next = (mode == DEBOUNCE_MODE_DISABLED) ? raw : (GpioSampler::getInstance().getState() & pinMask);
+		for (uint32_t changed = next ^ debounced; changed; changed &= changed - 1)
+		{
+			uint8_t pin = __builtin_ctz(changed);
+			acceptedAt[pin] = (mode == DEBOUNCE_MODE_DISABLED && changeMicros) ? changeMicros[pin] : nowMicros;
+			if (next & (1 << pin))
+				notePress(pin, changedAt[pin]);
+		}
+		return debounced = next;
+	}
+
+	for (uint32_t diff = raw ^ debounced; diff; diff &= diff - 1)
+	{
+		uint8_t pin = __builtin_ctz(diff);
+		bool accept;
+		if (mode == DEBOUNCE_MODE_EAGER && (raw & (1 << pin)))
+			accept = (nowMicros - acceptedAt[pin]) >= windows[pin]; // Press goes straight through, unless it's chatter from the last edge
+		else
+			accept = (nowMicros - changedAt[pin]) >= windows[pin];  // Level has to hold for the whole window
+
+		if (accept)
+		{
+			debounced ^= (1 << pin);
+			acceptedAt[pin] = nowMicros;
+			if (raw & (1 << pin))
+				notePress(pin, changedAt[pin]); // From the raw edge, so the debounce delay is part of the latency
+		}
+	}
+
+	return debounced;
+}
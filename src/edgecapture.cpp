@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "edgecapture.h"
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/structs/iobank0.h"
+#include "hardware/sync.h"
+
+#define EDGE_IRQ_EVENTS (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+static void __not_in_flash_func(edgeCallback)(uint gpio, uint32_t events)
+{
+	(void)events;
+
+	// Record the level as it is now, in case both edges latched before we got here
+	GpioEdge edge = { (uint8_t)gpio, !gpio_get(gpio), time_us_32() };
+	EdgeCapture::getInstance().push(edge);
+}
+
+// gpio_set_irq_enabled() only reaches the calling core's enables, this reaches the given core's
+static void setEdgeIrq(int core, uint pin, bool enabled)
+{
+	io_irq_ctrl_hw_t *irqCtrl = core ? &iobank0_hw->proc1_irq_ctrl : &iobank0_hw->proc0_irq_ctrl;
+	io_rw_32 *inte = &irqCtrl->inte[pin / 8];
+	uint32_t events = EDGE_IRQ_EVENTS << (4 * (pin % 8));
+	if (enabled)
+	{
+		gpio_acknowledge_irq(pin, EDGE_IRQ_EVENTS); // Drop edges latched while it was disarmed
+		hw_set_bits(inte, events);
+	}
+	else
+	{
+		hw_clear_bits(inte, events);
+	}
+}
+
+void EdgeCapture::setup(uint32_t newPinMask)
+{
+	if (irqCore < 0)
+	{
+		// No events, this only installs the callback and enables IO_IRQ_BANK0 on this core
+		irqCore = get_core_num();
+		gpio_set_irq_enabled_with_callback(0, 0, true, &edgeCallback);
+	}
+
+	uint32_t changed = pinMask ^ newPinMask;
+	pinMask &= newPinMask; // Stop queueing dropped pins before they're disarmed
+	for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+	{
+		if (changed & (1 << pin))
+			setEdgeIrq(irqCore, pin, newPinMask & (1 << pin));
+	}
+
+	pinMask = newPinMask;
+}
+
+void __not_in_flash_func(EdgeCapture::push)(const GpioEdge &edge)
+{
+	if (!(pinMask & (1 << edge.pin)))
+		return;
+
+	uint32_t next = (head + 1) & (EDGE_QUEUE_SIZE - 1);
+	if (next == tail)
+	{
+		overflows++;
+		return;
+	}
+
+	queue[head] = edge;
+	__dmb(); // Entry must land before the consumer can see the new head
+	head = next;
+}
+
+bool EdgeCapture::pop(GpioEdge &edge)
+{
+	if (head == tail)
+		return false;
+
+	edge = queue[tail];
+	__dmb();
+	tail = (tail + 1) & (EDGE_QUEUE_SIZE - 1);
+	return true;
+}
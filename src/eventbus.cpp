@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "eventbus.h"
+#include "gpaddon.h"
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+bool EventBus::subscribe(EventType type, GPAddon *addon)
+{
+	if (type >= EVENT_TYPE_COUNT || subscriberCount[type] >= EVENT_MAX_SUBSCRIBERS)
+		return false;
+
+	subscribers[type][subscriberCount[type]++] = addon;
+	return true;
+}
+
+bool EventBus::publish(const GamepadEvent &event)
+{
+	EventQueue &queue = queues[get_core_num()];
+	uint32_t head = queue.head;
+	uint32_t next = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+	if (next == queue.tail)
+	{
+		overflows++;
+		return false;
+	}
+
+	queue.entries[head] = event;
+	queue.entries[head].micros = time_us_32();
+	__dmb(); // Entry must land before the addon core can see the new head
+	queue.head = next;
+	__sev();
+	return true;
+}
+
+uint32_t EventBus::dispatch()
+{
+	return dispatch(queues[0]) + dispatch(queues[1]);
+}
+
+uint32_t EventBus::dispatch(EventQueue &queue)
+{
+	uint32_t handled = 0;
+	while (queue.head != queue.tail)
+	{
+		__dmb();
+		const GamepadEvent &event = queue.entries[queue.tail];
+		if (event.type < EVENT_TYPE_COUNT)
+		{
+			for (uint8_t i = 0; i < subscriberCount[event.type]; i++)
+				subscribers[event.type][i]->handleEvent(event);
+		}
+
+		__dmb(); // Done with the slot before the producer may reuse it
+		queue.tail = (queue.tail + 1) & (EVENT_QUEUE_SIZE - 1);
+		handled++;
+	}
+
+	return handled;
+}
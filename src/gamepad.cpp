@@ -5,7 +5,10 @@
 
 // GP2040 Libraries
 #include "gamepad.h"
+#include "edgecapture.h"
+#include "piosampler.h"
 #include "storagemanager.h"
+#include "switchstats.h"
 
 #include "FlashPROM.h"
 #include "CRC32.h"
@@ -67,48 +70,179 @@ void Gamepad::setup()
 		gpio_set_dir(PIN_SETTINGS, GPIO_IN); // Set as INPUT
 		gpio_pull_up(PIN_SETTINGS);          // Set as PULLUP
 	#endif
+
+	memset(edgeMicros, 0, sizeof(edgeMicros));
+	#if GAMEPAD_PIO_SAMPLER
+	PioSampler::getInstance().setup();
+	#endif
+	pinLUT = new uint32_t[GAMEPAD_LUT_COUNT][256];
+	remapProfile = (boardOptions.remapProfile < GAMEPAD_REMAP_PROFILES) ? boardOptions.remapProfile : 0;
+	updateMappings();
+}
+
+// Rebuild anything derived from the pin mappings, call after remapping pins
+void Gamepad::updateMappings()
+{
+	inputMask = 0;
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		inputMask |= gamepadMappings[i]->pinMask;
+
+	#ifdef PIN_SETTINGS
+	inputMask |= (1 << PIN_SETTINGS);
+	#endif
+
+	// Output bits each GPIO contributes, then spread into one table per byte of the GPIO word.
+	// The remap profile is folded in here, so it costs nothing per frame.
+	const BoardOptions &boardOptions = Storage::getInstance().getBoardOptionsRef();
+	const uint8_t *remap = boardOptions.remapProfiles[remapProfile];
+	bool remapIdentity = true;
+	uint32_t pinOutputs[32] = { };
+	memset(dpadPins, 0xFF, sizeof(dpadPins));
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		uint8_t target = remap[i];
+		remapIdentity &= (target == i);
+		if (gamepadMappings[i]->pin >= NUM_BANK0_GPIOS || target >= GAMEPAD_DIGITAL_INPUT_COUNT)
+			continue;
+
+		if (options.invertYAxis && target < 2) // Up <-> Down, on the remapped direction
+			target ^= 1;
+
+		GamepadButtonMapping *mapping = gamepadMappings[target];
+		bool isDpad = target < 4; // mapDpadUp..mapDpadRight come first
+		pinOutputs[gamepadMappings[i]->pin] |= isDpad ? (mapping->buttonMask << GAMEPAD_LUT_DPAD_SHIFT) : mapping->buttonMask;
+		if (isDpad)
+			dpadPins[target] = gamepadMappings[i]->pin;
+	}
+
+	#ifdef PIN_SETTINGS
+	pinOutputs[PIN_SETTINGS] |= (1 << (GAMEPAD_LUT_AUX_SHIFT + 0));
+	#endif
+
+	for (int table = 0; table < GAMEPAD_LUT_COUNT; table++)
+	{
+		for (int value = 0; value < 256; value++)
+		{
+			uint32_t output = 0;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				if (value & (1 << bit))
+					output |= pinOutputs[(table * 8) + bit];
+			}
+			pinLUT[table][value] = output;
+		}
+	}
+	lutInvertYAxis = options.invertYAxis;
+
+	// Any remap away from BoardConfig.h, or a remap profile, drops back to the tables
+	staticPins = false;
+	#if GAMEPAD_STATIC_PINS
+	staticPins = remapIdentity;
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		staticPins &= (gamepadMappings[i]->pin == staticPinMappings[i].pin);
+	#endif
+
+	// Debounce windows follow the buttons to whatever pins they're mapped to
+	debouncer.setMode(boardOptions.debounceMode < DEBOUNCE_MODE_COUNT ? (DebounceMode)boardOptions.debounceMode : GAMEPAD_DEBOUNCE_MODE);
+	debouncer.setPinMask(inputMask);
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		debouncer.setWindow(gamepadMappings[i]->pin, boardOptions.debounceMicros[i]);
+
+	hotkeys.compile(gamepadMappings);
+
+	#if GAMEPAD_EDGE_IRQ
+	EdgeCapture::getInstance().setup(inputMask);
+	#endif
+}
+
+void Gamepad::setRemapProfile(uint8_t profile)
+{
+	if (profile >= GAMEPAD_REMAP_PROFILES || profile == remapProfile)
+		return;
+
+	remapProfile = profile;
+	updateMappings();
+}
+
+// Held chords are hidden from the state, whatever the current remap profile turned their pins into
+void Gamepad::processHotkeys(uint32_t nowMicros)
+{
+	uint32_t chordPins = hotkeys.process(debouncer.debounced, nowMicros);
+	if (!chordPins)
+		return;
+
+	uint32_t output = pinLUT[0][chordPins & 0xFF]
+		| pinLUT[1][(chordPins >> 8) & 0xFF]
+		| pinLUT[2][(chordPins >> 16) & 0xFF]
+		| pinLUT[3][(chordPins >> 24) & 0xFF];
+	state.buttons &= ~(output & 0xFFFF);
+	state.dpad &= ~((output >> GAMEPAD_LUT_DPAD_SHIFT) & GAMEPAD_MASK_DPAD);
+	#ifdef PIN_SETTINGS
+	state.aux &= ~(output >> GAMEPAD_LUT_AUX_SHIFT);
+	#endif
+
+	if (hotkeys.held(HOTKEY_ACTION_HOME_BUTTON))
+		state.buttons |= GAMEPAD_MASK_A1;
 }
 
 void Gamepad::process()
 {
 	memcpy(&rawState, &state, sizeof(GamepadState));
+
+	// Opposing directions are settled here, so the MPGS cleaner only ever sees a clean d-pad
+	if (options.socdMode != socdCleaner.getMode())
+		socdCleaner.setMode(options.socdMode);
+
+	uint32_t pressMicros[4];
+	for (int i = 0; i < 4; i++)
+		pressMicros[i] = debouncer.changedMicros(dpadPins[i]);
+	state.dpad = socdCleaner.process(state.dpad, pressMicros);
+
 	MPGS::process();
 }
 
-void Gamepad::read()
+void Gamepad::debounce()
 {
-	// Need to invert since we're using pullups
-	uint32_t values = ~gpio_get_all();
+	uint32_t now = time_us_32();
+	#if GAMEPAD_EDGE_IRQ || GAMEPAD_PIO_SAMPLER
+	uint32_t debounced = debouncer.process(rawGpio, now, edgeMicros);
+	#else
+	uint32_t debounced = debouncer.process(rawGpio, now);
+	#endif
 
-	#ifdef PIN_SETTINGS
-	state.aux = 0
-		| ((values & (1 << PIN_SETTINGS)) ? (1 << 0) : 0)
-	;
+	#if GAMEPAD_PIO_SAMPLER && !GAMEPAD_EDGE_IRQ
+	SWITCH_STATS_SAMPLE(rawGpio, now, edgeMicros);
+	#elif !GAMEPAD_EDGE_IRQ
+	SWITCH_STATS_SAMPLE(rawGpio, now, nullptr);
+	#endif
+	SWITCH_STATS_ACTUATED(debouncer.pressed);
+
+	if (debounced != rawGpio)
+		translate(debounced);
+}
+
+void Gamepad::read()
+{
+	#if GAMEPAD_EDGE_IRQ
+	// Drain captured edges, GPIO levels below stay the source of truth for state
+	GpioEdge edge;
+	while (EdgeCapture::getInstance().pop(edge)) {
+		edgeMicros[edge.pin] = edge.micros;
+		SWITCH_STATS_EDGE(edge.pin, edge.micros); // Every edge, the levels below can miss a bounce
+	}
 	#endif
 
-	state.dpad = 0
-		| ((values & mapDpadUp->pinMask)    ? (options.invertYAxis ? mapDpadDown->buttonMask : mapDpadUp->buttonMask) : 0)
-		| ((values & mapDpadDown->pinMask)  ? (options.invertYAxis ? mapDpadUp->buttonMask : mapDpadDown->buttonMask) : 0)
-		| ((values & mapDpadLeft->pinMask)  ? mapDpadLeft->buttonMask  : 0)
-		| ((values & mapDpadRight->pinMask) ? mapDpadRight->buttonMask : 0)
-	;
-
-	state.buttons = 0
-		| ((values & mapButtonB1->pinMask)  ? mapButtonB1->buttonMask  : 0)
-		| ((values & mapButtonB2->pinMask)  ? mapButtonB2->buttonMask  : 0)
-		| ((values & mapButtonB3->pinMask)  ? mapButtonB3->buttonMask  : 0)
-		| ((values & mapButtonB4->pinMask)  ? mapButtonB4->buttonMask  : 0)
-		| ((values & mapButtonL1->pinMask)  ? mapButtonL1->buttonMask  : 0)
-		| ((values & mapButtonR1->pinMask)  ? mapButtonR1->buttonMask  : 0)
-		| ((values & mapButtonL2->pinMask)  ? mapButtonL2->buttonMask  : 0)
-		| ((values & mapButtonR2->pinMask)  ? mapButtonR2->buttonMask  : 0)
-		| ((values & mapButtonS1->pinMask)  ? mapButtonS1->buttonMask  : 0)
-		| ((values & mapButtonS2->pinMask)  ? mapButtonS2->buttonMask  : 0)
-		| ((values & mapButtonL3->pinMask)  ? mapButtonL3->buttonMask  : 0)
-		| ((values & mapButtonR3->pinMask)  ? mapButtonR3->buttonMask  : 0)
-		| ((values & mapButtonA1->pinMask)  ? mapButtonA1->buttonMask  : 0)
-		| ((values & mapButtonA2->pinMask)  ? mapButtonA2->buttonMask  : 0)
-	;
+	// Y-axis inversion is baked into the tables, a hotkey can toggle it at any time
+	if (options.invertYAxis != lutInvertYAxis)
+		updateMappings();
+
+	// Need to invert since we're using pullups
+	#if GAMEPAD_PIO_SAMPLER
+	rawGpio = PioSampler::getInstance().read(inputMask, edgeMicros);
+	#else
+	rawGpio = ~gpio_get_all() & inputMask;
+	#endif
+	translate(rawGpio);
 
 	state.lx = GAMEPAD_JOYSTICK_MID;
 	state.ly = GAMEPAD_JOYSTICK_MID;
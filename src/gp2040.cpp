@@ -1,44 +1,60 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "helper.h"
+#include "bootstats.h"
+#include "edgecapture.h"
+#include "eventbus.h"
+#include "inputtrace.h"
+#include "switchstats.h"
+#include "piosampler.h"
+#include "perfstats.h"
+#include "scheduler.h"
 #include "configmanager.h" // Managers
 #include "storagemanager.h"
 
-#include "inputs/analog.h" // Inputs
-#include "inputs/jslider.h"
-#include "inputs/turbo.h"
-
 // Pico includes
 #include "pico/bootrom.h"
+#include "hardware/watchdog.h"
 
 // TinyUSB
 #include "usb_driver.h"
+#include "sof_sync.h"
+#include "input_latency.h"
 #include "tusb.h"
 
-#define GAMEPAD_DEBOUNCE_MILLIS 5 // make this a class object
-
-GP2040::GP2040() : nextRuntime(0) {
-	Storage::getInstance().SetGamepad(new Gamepad(GAMEPAD_DEBOUNCE_MILLIS));
-	Storage::getInstance().SetProcessedGamepad(new Gamepad(GAMEPAD_DEBOUNCE_MILLIS));
+GP2040::GP2040() : nextRuntime(0), pollMicros(GAMEPAD_POLL_MICRO), inputsReady(false), booted(false), pipelineMicros(0), lastGpioValues(0), reportPending(true), pendingInputMode(INPUT_MODE_PENDING_NONE) {
+	Storage::getInstance().SetGamepad(new Gamepad());
+	Storage::getInstance().SetProcessedGamepad(new Gamepad());
+	BootStats::getInstance().mark(BOOT_STAGE_STORAGE);
 }
 
 GP2040::~GP2040() {
 }
 
 void GP2040::setup() {	
+#if GAMEPAD_PERF_STATS
+	PerfStats::getInstance().setup();
+#endif
+
     // Setup Gamepad and Gamepad Storage
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
 	gamepad->setup();
 
 	// Check for Config or Regular Input (w/ Button Combos)
 	InputMode inputMode = gamepad->options.inputMode;
+	uint8_t pollInterval = Storage::getInstance().getBoardOptions().pollInterval;
+	pollMicros = GAMEPAD_POLL_MICRO * (pollInterval ? pollInterval : 1);
 	gamepad->read();
+	BootStats::getInstance().mark(BOOT_STAGE_GAMEPAD);
+	bool configRequested = watchdog_hw->scratch[CONFIG_MODE_SCRATCH] == CONFIG_MODE_MAGIC; // Config mode hotkey
+	watchdog_hw->scratch[CONFIG_MODE_SCRATCH] = 0;
 	if (gamepad->pressedF1() && gamepad->pressedUp()) { // BOOTSEL - Go to UF2 Flasher
 		reset_usb_boot(0, 0);
-	} else if (gamepad->pressedS2()) { 					// START - Config Mode
+	} else if (gamepad->pressedS2() || configRequested) { // START - Config Mode
 		Storage::getInstance().SetConfigMode(true);
 		inputMode = INPUT_MODE_CONFIG; // force config
         initialize_driver(inputMode);
+		BootStats::getInstance().mark(BOOT_STAGE_USB_INIT);
 		ConfigManager::getInstance().setup(CONFIG_TYPE_WEB);
 	} else { 											// Gamepad Mode
 		Storage::getInstance().SetConfigMode(false);
@@ -52,60 +68,366 @@ void GP2040::setup() {
 			gamepad->options.inputMode = inputMode;
 			gamepad->save();
 		}
-		initialize_driver(inputMode);
+		initialize_driver(inputMode, pollInterval);
+		BootStats::getInstance().mark(BOOT_STAGE_USB_INIT);
 	}
 
-	// Setup Add-on Inputs
+	BootStats::getInstance().setup(!Storage::getInstance().GetConfigMode()); // Kept for web config, like the trace
+#if GAMEPAD_INPUT_TRACE
+	InputTrace::getInstance().setup(!Storage::getInstance().GetConfigMode()); // Web config shows the last trace
+#endif
+	input_latency_setup(!Storage::getInstance().GetConfigMode()); // Same for the latency histograms
+#if GAMEPAD_SWITCH_STATS
+	SwitchStats::getInstance().setup(Storage::getInstance().GetConfigMode());
+#endif
+
+#if GAMEPAD_FAST_BOOT
+	if (Storage::getInstance().GetConfigMode() || inputCoreLayout()) // Nothing to rush in config mode, and the input core needs them from the start
+		setupInputs();
+#else
+	setupInputs();
+#endif
+}
+
+// Setup Add-on Inputs
+void GP2040::setupInputs() {
+#if GAMEPAD_STATIC_ADDONS
+	inputAddons.setup(Storage::getInstance().Inputs);
+#else
 	setupInput(new AnalogInput());
 	setupInput(new JSliderInput());
 	setupInput(new TurboInput());
+	setupInput(new MacroInput());
+#endif
+	inputsReady = true;
+	BootStats::getInstance().mark(BOOT_STAGE_INPUTS);
+}
+
+// Boot milestones after setup, and the deferred fast-boot setup once the first report is out
+void GP2040::bootProgress() {
+	if (!tud_mounted())
+		return;
+
+	BootStats::getInstance().mark(BOOT_STAGE_USB_MOUNTED);
+	if (reportPending)
+		return;
+
+	BootStats::getInstance().mark(BOOT_STAGE_FIRST_REPORT);
+	if (!inputsReady)
+		setupInputs();
+	booted = true;
+}
+
+bool GP2040::inputCoreLayout() {
+	return GAMEPAD_CORE_LAYOUT == CORE_LAYOUT_INPUT_CORE && !Storage::getInstance().GetConfigMode();
 }
 
 void GP2040::run() {
+	if (inputCoreLayout()) {
+		runUsb();
+		return;
+	}
+
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
-	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
 	bool configMode = Storage::getInstance().GetConfigMode();
 	while (1) { // LOOP
 		// Config Loop (Web-Config does not require gamepad)
 		if (configMode == true ) {
 			ConfigManager::getInstance().loop();
+			SWITCH_STATS_CHECKPOINT(getMicro());
+		#if GAMEPAD_PERF_STATS
+			// Keep the GPIO stages timed so the profiler has live numbers. Nothing past them runs,
+			// the hotkeys, addons and MPGS processing would act on options web config owns.
+			if (getMicro() >= nextRuntime) {
+				PERF_BEGIN();
+				gamepad->read();
+				PERF_END(PERF_STAGE_READ);
+				gamepad->debounce();
+				PERF_END(PERF_STAGE_DEBOUNCE);
+				nextRuntime = getMicro() + pollMicros;
+			}
+		#endif
 			continue;
 		}
 
-		if (nextRuntime > getMicro()) { // fix for unsigned
-			sleep_us(50); // Give some time back to our CPU (lower power consumption)
+		uint64_t now = getMicro();
+		if (nextRuntime > now) { // fix for unsigned
+		#if GAMEPAD_SOF_SYNC
+			if (sof_sync_locked()) {
+				// Keep SOF and IN events timely while we wait for the deadline. The USB interrupt ends the sleep
+				// early, and tud_task() then logs the SOF close to when it arrived.
+				tud_task();
+				uint64_t nextFrame = sof_sync_next_frame(now);
+				Scheduler::sleepUntil(nextFrame < nextRuntime ? nextFrame : nextRuntime);
+				continue;
+			}
+		#endif
+		#if GAMEPAD_EDGE_IRQ
+			// Sleep until the next poll, but run right away if an input edge comes in
+			if (EdgeCapture::getInstance().empty()) {
+				Scheduler::sleepUntil(nextRuntime);
+				continue;
+			}
+		#else
+			Scheduler::sleepUntil(nextRuntime); // Give time back to our CPU until the next poll (lower power consumption)
 			continue;
+		#endif
 		}
 
-		// Gamepad Features
-		gamepad->read(); 	// gpio pin reads
-	#if GAMEPAD_DEBOUNCE_MILLIS > 0
-		gamepad->debounce();
+		// Skip straight to USB upkeep while nothing has changed
+		if (inputsDirty(gamepad, now)) {
+			sof_sync_input_sampled(now);
+			processInputs(gamepad, now);
+			if (gamepad->debouncer.pressed)
+				input_latency_press(gamepad->debouncer.pressMicros);
+
+			// USB FEATURES : Send/Get USB Features (including Player LEDs on X-Input)
+			reportPending = !send_report(gamepad->getReport(), gamepad->getReportSize());
+			if (!reportPending)
+				INPUT_TRACE_CAPTURE(gamepad->state, gamepad->rawGpio);
+			PERF_END(PERF_STAGE_SEND_REPORT);
+			PERF_RECORD_MICROS(PERF_STAGE_REPORT_AGE, getMicro() - now);
+		} else {
+			PERF_BEGIN();
+		}
+
+		if (!booted)
+			bootProgress();
+		SWITCH_STATS_CHECKPOINT(now);
+
+		Storage::getInstance().ClearFeatureData();
+		receive_report(Storage::getInstance().GetFeatureData());
+		Storage::getInstance().PublishFeatureData();
+		PERF_END(PERF_STAGE_RECEIVE_REPORT);
+		tud_task(); // TinyUSB Task update
+		usb_driver_task();
+		PERF_END(PERF_STAGE_TUD_TASK);
+
+	#if GAMEPAD_SOF_SYNC
+		// Lead the IN token by the recent worst-case pipeline time, decaying slowly after a spike
+		uint32_t elapsed = getMicro() - now;
+		pipelineMicros = (elapsed > pipelineMicros) ? elapsed : pipelineMicros - (pipelineMicros >> 4);
+		if (sof_sync_locked()) {
+			nextRuntime = sof_sync_next_deadline(getMicro(), pipelineMicros + GAMEPAD_SOF_MARGIN_MICRO);
+			continue;
+		}
 	#endif
-		gamepad->hotkey(); 	// check for MPGS hotkeys
-		gamepad->process(); // process through MPGS
+		nextRuntime = getMicro() + pollMicros;
+	}
+}
+
+// CORE_LAYOUT_INPUT_CORE: nothing but the input loop, at a fixed period, publishing through the snapshot
+void GP2040::runInputCore() {
+#if GAMEPAD_PERF_STATS
+	PerfStats::getInstance().setupCore();
+#endif
+
+	Gamepad * gamepad = Storage::getInstance().GetGamepad();
+	uint64_t nextSample = getMicro();
+	while (1) {
+		// Nothing else runs on this core, spin so every pass starts on time
+		uint64_t now = getMicro();
+		if (now < nextSample)
+			continue;
+
+		nextSample += GAMEPAD_INPUT_CORE_MICRO;
+		if (nextSample <= now) // Fell a whole period behind, don't try to catch up
+			nextSample = now + GAMEPAD_INPUT_CORE_MICRO;
+
+		if (inputsDirty(gamepad, now))
+			processInputs(gamepad, now);
+	}
+}
+
+// CORE_LAYOUT_INPUT_CORE: each new snapshot from core1 goes out as a report, the aux addons fit in between
+void GP2040::runUsb() {
+	Gamepad * gamepad = Storage::getInstance().GetGamepad();
+	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
+	Scheduler &scheduler = Scheduler::getInstance();
+	scheduler.setup(Storage::getInstance().Addons);
 
-		// Loop through all input modifiers/features (Analog Sticks, Turbo Buttons, Macro Inputs, Touch Screens, etc.) 
-		for (std::vector<GPAddon*>::iterator it = Storage::getInstance().Inputs.begin(); it != Storage::getInstance().Inputs.end(); it++) {
-			(*it)->process();
+	uint32_t reportVersion = 0;
+	uint32_t agedVersion = 0; // Last version timed into report_age, a retried report only counts once
+	uint32_t pressMicros = 0;
+	while (1) {
+		// Re-enumerating is a USB call, so the input mode hotkey is handed over from core1
+		if (pendingInputMode != INPUT_MODE_PENDING_NONE) {
+			InputMode inputMode = (InputMode)pendingInputMode;
+			pendingInputMode = INPUT_MODE_PENDING_NONE;
+			switchInputMode(gamepad, inputMode);
 		}
 
-		// Copy Processed Gamepad
-		memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+		uint32_t version = Storage::getInstance().SyncSnapshot();
+		if (version != reportVersion || reportPending) {
+			reportVersion = version;
+			snapshot.state = processedGamepad->state;
+			snapshot.options = gamepad->options; // Hotkeys change these on core1
+			if (Storage::getInstance().GetSnapshotPressMicros() != pressMicros) {
+				pressMicros = Storage::getInstance().GetSnapshotPressMicros();
+				input_latency_press(pressMicros);
+			}
+
+			reportPending = !send_report(snapshot.getReport(), snapshot.getReportSize());
+			if (!reportPending)
+				INPUT_TRACE_CAPTURE(snapshot.state, Storage::getInstance().GetSnapshotGpio());
+			if (!reportPending && reportVersion != agedVersion) {
+				agedVersion = reportVersion;
+				PERF_RECORD_MICROS(PERF_STAGE_REPORT_AGE, time_us_32() - Storage::getInstance().GetSnapshotMicros());
+			}
+		}
+
+		if (!booted)
+			bootProgress();
+		SWITCH_STATS_CHECKPOINT(time_us_64());
 
-		// USB FEATURES : Send/Get USB Features (including Player LEDs on X-Input)
-		send_report(gamepad->getReport(), gamepad->getReportSize());
 		Storage::getInstance().ClearFeatureData();
 		receive_report(Storage::getInstance().GetFeatureData());
+		Storage::getInstance().PublishFeatureData();
 		tud_task(); // TinyUSB Task update
+		usb_driver_task();
+
+		// At most one addon per pass, a long one (display refresh) holds the next report back
+		scheduler.poll();
+	}
+}
 
-		nextRuntime = getMicro() + GAMEPAD_POLL_MICRO;
+// Gamepad Features
+void GP2040::processInputs(Gamepad * gamepad, uint64_t now) {
+	PERF_BEGIN();
+	gamepad->read(); 	// gpio pin reads
+	PERF_END(PERF_STAGE_READ);
+	gamepad->debounce();
+	PERF_END(PERF_STAGE_DEBOUNCE);
+	uint32_t firedHotkeys = 0;
+	gamepad->processHotkeys(now);
+	HotkeyAction action;
+	while (gamepad->hotkeys.pop(action)) {
+		handleHotkey(gamepad, action);
+		firedHotkeys |= 1u << action.type;
 	}
+	PERF_END(PERF_STAGE_HOTKEY);
+	gamepad->process(); // process through MPGS
+	PERF_END(PERF_STAGE_PROCESS);
+
+	// Loop through all input modifiers/features (Analog Sticks, Turbo Buttons, Macro Inputs, Touch Screens, etc.) 
+	FrameContext frame(gamepad, lastState, Storage::getInstance().getBoardOptionsRef(), now, firedHotkeys);
+#if GAMEPAD_STATIC_ADDONS
+	inputAddons.process(frame);
+#else
+	std::vector<GPAddon*> &inputs = Storage::getInstance().Inputs;
+	for (uint8_t i = 0; i < inputs.size(); i++) {
+		inputs[i]->process(frame);
+		PERF_END(PERF_STAGE_INPUTS + i);
+	}
+#endif
+	lastState = frame.current;
+
+	// Publish Processed Gamepad (the other core reads it through the snapshot)
+	Storage::getInstance().PublishGamepadState(gamepad, now);
+	PERF_END(PERF_STAGE_COPY);
+}
+
+// Apply a fired hotkey on the input side, then pass it on to the addons (the LED hotkeys are theirs alone)
+void GP2040::handleHotkey(Gamepad * gamepad, const HotkeyAction &action) {
+	switch (action.type) {
+		case HOTKEY_ACTION_DPAD_MODE:
+			gamepad->options.dpadMode = (DpadMode)action.param;
+			gamepad->save();
+			break;
+
+		case HOTKEY_ACTION_SOCD_MODE:
+			gamepad->options.socdMode = (SOCDMode)action.param;
+			gamepad->save();
+			break;
+
+		case HOTKEY_ACTION_INVERT_Y_AXIS:
+			gamepad->options.invertYAxis = !gamepad->options.invertYAxis;
+			gamepad->save();
+			break;
+
+		case HOTKEY_ACTION_INPUT_MODE:
+		#if GAMEPAD_CORE_LAYOUT == CORE_LAYOUT_SHARED
+			switchInputMode(gamepad, (InputMode)action.param);
+		#else
+			pendingInputMode = action.param; // The USB core picks it up
+		#endif
+			break;
+
+		case HOTKEY_ACTION_REMAP_PROFILE:
+			gamepad->setRemapProfile(action.param);
+			break;
+
+		case HOTKEY_ACTION_CONFIG_MODE:
+			watchdog_hw->scratch[CONFIG_MODE_SCRATCH] = CONFIG_MODE_MAGIC;
+			watchdog_reboot(0, 0, EEPROM_WRITE_WAIT * 2); // Let a pending settings write finish first
+			break;
+	}
+
+	GamepadEvent event;
+	event.type = EVENT_HOTKEY;
+	event.hotkey = action;
+	EventBus::getInstance().publish(event);
+}
+
+void GP2040::switchInputMode(Gamepad * gamepad, InputMode inputMode) {
+	if (switch_input_mode(inputMode)) {
+		gamepad->options.inputMode = inputMode;
+		gamepad->save(); // USB is detached for a while anyway
+		reportPending = true;
+	}
+}
+
+// True if the processing pipeline has work to do this frame
+bool GP2040::inputsDirty(Gamepad * gamepad, uint64_t now) {
+	uint32_t gpioValues = gamepad->sampleGpio();
+	if (gpioValues != lastGpioValues) {
+		lastGpioValues = gpioValues;
+		return true;
+	}
+
+#if GAMEPAD_CORE_LAYOUT == CORE_LAYOUT_SHARED
+	if (reportPending) // The USB core retries on its own with CORE_LAYOUT_INPUT_CORE
+		return true;
+#endif
+
+	if (gamepad->debouncing()) // Debouncer may still be holding an edge back
+		return true;
+
+	if (gamepad->hotkeys.pending()) // A HOLD chord fires on time alone, with the stick sitting still
+		return true;
+
+#if GAMEPAD_PIO_SAMPLER
+	// Same for pulses between polls, they're in the sample ring
+	if (PioSampler::getInstance().changed(gamepad->inputMask))
+		return true;
+#endif
+
+#if GAMEPAD_EDGE_IRQ
+	// A bounce can come and go between polls, still drain it
+	if (!EdgeCapture::getInstance().empty())
+		return true;
+#endif
+
+#if GAMEPAD_STATIC_ADDONS
+	return inputAddons.dirty();
+#else
+	for (std::vector<GPAddon*>::iterator it = Storage::getInstance().Inputs.begin(); it != Storage::getInstance().Inputs.end(); it++) {
+		if ((*it)->dirty())
+			return true;
+	}
+
+	return false;
+#endif
 }
 
 void GP2040::setupInput(GPAddon* input) {
 	if (input->available()) {
+		uint32_t start = time_us_32();
 		input->setup();
+		BootStats::getInstance().addonSetup(input->name(), time_us_32() - start);
 		Storage::getInstance().Inputs.push_back(input);
+	#if GAMEPAD_PERF_STATS
+		PerfStats::getInstance().addStage(input->name());
+	#endif
 	}
 }
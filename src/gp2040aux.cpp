@@ -1,6 +1,8 @@
 // GP2040 includes
 #include "gp2040aux.h"
 #include "gamepad.h"
+#include "bootstats.h"
+#include "scheduler.h"
 #include "storagemanager.h" // Managers
 #include "addons/i2cdisplay.h" // Add-Ons
 #include "addons/neopicoleds.h"
@@ -15,22 +17,26 @@ GP2040Aux::~GP2040Aux() {
 }
 
 void GP2040Aux::setup() {
+	BootStats::getInstance().mark(BOOT_STAGE_AUX_START);
+	// The scheduler calls these through GPAddon with its own timing, a compile-time pipeline buys nothing here
 	setupAddon(new I2CDisplayAddon());
 	setupAddon(new NeoPicoLEDAddon());
 	setupAddon(new PlayerLEDAddon());
+	BootStats::getInstance().mark(BOOT_STAGE_AUX_READY);
 }
 
 void GP2040Aux::run() {
-	while (1) {
-		for (std::vector<GPAddon*>::iterator it = Storage::getInstance().Addons.begin(); it != Storage::getInstance().Addons.end(); it++) {
-			(*it)->process();
-		}
-	}
+	// Addons run at their own period and priority, the core sleeps in between
+	Scheduler &scheduler = Scheduler::getInstance();
+	scheduler.setup(Storage::getInstance().Addons);
+	scheduler.run();
 }
 
 void GP2040Aux::setupAddon(GPAddon* addon) {
 	if (addon->available()) {
+		uint32_t start = time_us_32();
 		addon->setup();
+		BootStats::getInstance().addonSetup(addon->name(), time_us_32() - start);
 		Storage::getInstance().Addons.push_back(addon);
 	}
 }
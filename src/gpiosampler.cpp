@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "gpiosampler.h"
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+
+static uint samplerAlarm;
+
+// Re-arms from the previous target rather than from now, so the sample clock doesn't drift with IRQ latency
+static void __not_in_flash_func(samplerIrq)()
+{
+	GpioSampler &sampler = GpioSampler::getInstance();
+	timer_hw->intr = 1u << samplerAlarm;
+
+	sampler.nextSample += sampler.periodMicros;
+	if ((int32_t)(sampler.nextSample - timer_hw->timerawl) <= 0) // Held off for a whole period, skip ahead
+		sampler.nextSample = timer_hw->timerawl + sampler.periodMicros;
+	timer_hw->alarm[samplerAlarm] = sampler.nextSample;
+
+	sampler.sample();
+}
+
+void GpioSampler::start()
+{
+	if (running())
+		return;
+
+	memset(counter, 0, sizeof(counter));
+	state = ~gpio_get_all() & GPIO_SAMPLER_PIN_MASK;
+	periodMicros = 1000000 / GAMEPAD_SAMPLE_HZ;
+
+	alarm = hardware_alarm_claim_unused(true);
+	samplerAlarm = alarm;
+	irq_set_exclusive_handler(TIMER_IRQ_0 + alarm, samplerIrq);
+	hw_set_bits(&timer_hw->inte, 1u << alarm);
+	irq_set_enabled(TIMER_IRQ_0 + alarm, true);
+
+	nextSample = timer_hw->timerawl + periodMicros;
+	timer_hw->alarm[alarm] = nextSample;
+}
+
+void GpioSampler::stop()
+{
+	if (!running())
+		return;
+
+	irq_set_enabled(TIMER_IRQ_0 + alarm, false);
+	hw_clear_bits(&timer_hw->inte, 1u << alarm);
+	timer_hw->armed = 1u << alarm; // Disarm, and drop one that already fired
+	timer_hw->intr = 1u << alarm;
+	irq_remove_handler(TIMER_IRQ_0 + alarm, samplerIrq);
+	hardware_alarm_unclaim(alarm);
+	alarm = -1;
+}
+
+void __not_in_flash_func(GpioSampler::sample)()
+{
+	// Count up every pin that reads differently from its debounced level, reset the rest
+	uint32_t delta = (~gpio_get_all() & GPIO_SAMPLER_PIN_MASK) ^ state;
+	uint32_t carry = delta;
+	for (int bit = 0; bit < GAMEPAD_SAMPLE_COUNTER_BITS; bit++)
+	{
+		uint32_t overflow = counter[bit] & carry;
+		counter[bit] = (counter[bit] ^ carry) & delta;
+		carry = overflow;
+	}
+
+	state ^= carry; // Counters that rolled over have differed for 2^bits samples, and are back at 0
+}
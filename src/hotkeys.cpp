@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "hotkeys.h"
+#include "gamepad.h"
+#include "socd.h"
+#include "AnimationStation.hpp"
+
+static const HotkeyBinding hotkeyBindings[] =
+{
+	// MPGS hotkeys
+	{ HOTKEY_MODIFIER_F1, 0, GAMEPAD_MASK_UP,    HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_HOME_BUTTON, 0 } },
+	{ HOTKEY_MODIFIER_F1, 0, GAMEPAD_MASK_DOWN,  HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_DPAD_MODE, DPAD_MODE_DIGITAL } },
+	{ HOTKEY_MODIFIER_F1, 0, GAMEPAD_MASK_LEFT,  HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_DPAD_MODE, DPAD_MODE_LEFT_ANALOG } },
+	{ HOTKEY_MODIFIER_F1, 0, GAMEPAD_MASK_RIGHT, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_DPAD_MODE, DPAD_MODE_RIGHT_ANALOG } },
+	{ HOTKEY_MODIFIER_F2, 0, GAMEPAD_MASK_UP,    HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_SOCD_MODE, SOCD_MODE_UP_PRIORITY } },
+	{ HOTKEY_MODIFIER_F2, 0, GAMEPAD_MASK_DOWN,  HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_SOCD_MODE, SOCD_MODE_NEUTRAL } },
+	{ HOTKEY_MODIFIER_F2, 0, GAMEPAD_MASK_LEFT,  HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_SOCD_MODE, SOCD_MODE_SECOND_INPUT_PRIORITY } },
+	{ HOTKEY_MODIFIER_F2, 0, GAMEPAD_MASK_RIGHT, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_INVERT_Y_AXIS, 0 } },
+
+	// Input mode, same buttons as the boot-time selection
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_B1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_INPUT_MODE, INPUT_MODE_SWITCH } },
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_B2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_INPUT_MODE, INPUT_MODE_XINPUT } },
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_B3, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_INPUT_MODE, INPUT_MODE_HID } },
+
+	// Button remap profiles
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_L1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_REMAP_PROFILE, 0 } },
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_R1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_REMAP_PROFILE, 1 } },
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_L2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_REMAP_PROFILE, 2 } },
+	{ HOTKEY_MODIFIER_F2, GAMEPAD_MASK_R2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_REMAP_PROFILE, 3 } },
+
+	// Macro
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_L3, 0, HOTKEY_TRIGGER_HOLD, 1000, { HOTKEY_ACTION_MACRO_RECORD, 0 } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_R3, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_MACRO_PLAY, 0 } },
+
+	// Web config without a power cycle, so the input trace survives for download
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_A1, 0, HOTKEY_TRIGGER_HOLD, 3000, { HOTKEY_ACTION_CONFIG_MODE, 0 } },
+
+	// RGB LEDs
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_B3, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_ANIMATION_UP } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_B1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_ANIMATION_DOWN } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_B4, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_BRIGHTNESS_UP } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_B2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_BRIGHTNESS_DOWN } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_R1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_PARAMETER_UP } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_R2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_PARAMETER_DOWN } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_L1, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_PRESS_PARAMETER_UP } },
+	{ HOTKEY_MODIFIER_F1, GAMEPAD_MASK_L2, 0, HOTKEY_TRIGGER_PRESS, 0, { HOTKEY_ACTION_LEDS, HOTKEY_LEDS_PRESS_PARAMETER_DOWN } },
+};
+
+// Pins behind these buttons/directions, 0 if any of them isn't mapped to a pin
+static uint32_t pinsFor(GamepadButtonMapping **mappings, uint16_t buttons, uint8_t dpad)
+{
+	uint32_t pins = 0;
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		bool isDpad = i < 4; // mapDpadUp..mapDpadRight come first
+		if (!(isDpad ? (dpad & mappings[i]->buttonMask) : (buttons & mappings[i]->buttonMask)))
+			continue;
+		if (mappings[i]->pin >= NUM_BANK0_GPIOS)
+			return 0;
+		pins |= mappings[i]->pinMask;
+	}
+
+	return pins;
+}
+
+void HotkeyEngine::compile(GamepadButtonMapping **mappings)
+{
+#ifdef PIN_SETTINGS
+	uint32_t f1Pins = (1 << PIN_SETTINGS);
+#else
+	uint32_t f1Pins = pinsFor(mappings, GAMEPAD_MASK_S1 | GAMEPAD_MASK_S2, 0);
+#endif
+	uint32_t f2Pins = pinsFor(mappings, GAMEPAD_MASK_S2 | GAMEPAD_MASK_A1, 0);
+
+	HotkeyEntry compiled[HOTKEY_MAX_ENTRIES];
+	uint8_t compiledCount = 0;
+	uint32_t compiledModifierPins = 0;
+	for (const HotkeyBinding &binding : hotkeyBindings)
+	{
+		uint32_t modifier = (binding.modifier == HOTKEY_MODIFIER_F1) ? f1Pins : f2Pins;
+		uint32_t pins = pinsFor(mappings, binding.buttons, binding.dpad);
+		if (!modifier || !pins || compiledCount >= HOTKEY_MAX_ENTRIES) // Can't be pressed on this board
+			continue;
+
+		HotkeyEntry entry = {};
+		entry.chordPins = modifier | pins;
+		entry.holdMicros = binding.holdMillis * 1000;
+		entry.trigger = binding.trigger;
+		entry.action = binding.action;
+		compiledModifierPins |= modifier;
+
+		// Insertion sort, most pins first, so a chord is always checked before its subsets
+		uint8_t count = __builtin_popcount(entry.chordPins);
+		uint8_t index = compiledCount++;
+		for (; index > 0 && __builtin_popcount(compiled[index - 1].chordPins) < count; index--)
+			compiled[index] = compiled[index - 1];
+		compiled[index] = entry;
+	}
+
+	// Hotkeys themselves lead here (Y-axis, remap profile), keep the held chords held so they don't fire again
+	bool unchanged = (compiledCount == entryCount);
+	for (uint8_t i = 0; unchanged && i < entryCount; i++)
+		unchanged = (compiled[i].chordPins == entries[i].chordPins);
+	if (unchanged)
+		return;
+
+	for (uint8_t i = 0; i < compiledCount; i++)
+		entries[i] = compiled[i];
+	entryCount = compiledCount;
+	modifierPins = compiledModifierPins;
+	activeMask = 0;
+	waitingMask = 0;
+}
+
+uint32_t HotkeyEngine::match(uint32_t pins, uint32_t nowMicros)
+{
+	uint32_t heldPins = 0;
+	for (uint8_t i = 0; i < entryCount; i++)
+	{
+		HotkeyEntry &entry = entries[i];
+		uint32_t bit = (1 << i);
+		bool down = ((pins & entry.chordPins) == entry.chordPins) && ((heldPins & entry.chordPins) != entry.chordPins);
+
+		if (down)
+		{
+			if (!(activeMask & bit))
+			{
+				activeMask |= bit;
+				entry.heldSince = nowMicros;
+				entry.fired = false;
+				if (entry.trigger != HOTKEY_TRIGGER_PRESS)
+					waitingMask |= bit;
+			}
+
+			if (!entry.fired
+				&& (entry.trigger == HOTKEY_TRIGGER_PRESS
+				|| (entry.trigger == HOTKEY_TRIGGER_HOLD && (nowMicros - entry.heldSince) >= entry.holdMicros)))
+			{
+				push(entry.action);
+				entry.fired = true;
+				waitingMask &= ~bit;
+			}
+
+			heldPins |= entry.chordPins;
+		}
+		else if (activeMask & bit)
+		{
+			activeMask &= ~bit;
+			waitingMask &= ~bit;
+			if (entry.trigger == HOTKEY_TRIGGER_TAP && (nowMicros - entry.heldSince) < entry.holdMicros)
+				push(entry.action);
+		}
+	}
+
+	return heldPins;
+}
+
+bool HotkeyEngine::held(uint8_t type)
+{
+	for (uint32_t active = activeMask; active; active &= active - 1)
+	{
+		if (entries[__builtin_ctz(active)].action.type == type)
+			return true;
+	}
+
+	return false;
+}
+
+void HotkeyEngine::push(const HotkeyAction &action)
+{
+	uint8_t next = (head + 1) & (HOTKEY_QUEUE_SIZE - 1);
+	if (next == tail) // Full, the input loop drains it every frame so this is a burst of chords
+		return;
+
+	queue[head] = action;
+	head = next;
+}
+
+bool HotkeyEngine::pop(HotkeyAction &action)
+{
+	if (head == tail)
+		return false;
+
+	action = queue[tail];
+	tail = (tail + 1) & (HOTKEY_QUEUE_SIZE - 1);
+	return true;
+}
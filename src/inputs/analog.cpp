@@ -18,9 +18,9 @@ void AnalogInput::setup() {
     adc_gpio_init(ANALOG_ADC_VRY);
 }
 
-void AnalogInput::process()
+void AnalogInput::process(const FrameContext &frame)
 {
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    Gamepad * gamepad = frame.gamepad;
     adc_select_input(0); // ANALOG-X
     float adc_x = ((float)adc_read())/ADC_MAX;
     adc_select_input(1); // ANALOG-Y
@@ -25,7 +25,7 @@ void JSliderInput::setup()
 }
 
 DpadMode JSliderInput::read() {
-    BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
+    const BoardOptions & boardOptions = Storage::getInstance().getBoardOptionsRef();
     if ( boardOptions.pinSliderLS != (uint8_t)-1 && boardOptions.pinSliderRS != (uint8_t)-1) {
         if ( !gpio_get(boardOptions.pinSliderLS)) {
             return DPAD_MODE_LEFT_ANALOG;
@@ -36,9 +36,8 @@ DpadMode JSliderInput::read() {
     return  DPAD_MODE_DIGITAL;
 }
 
-void JSliderInput::debounce()
+void JSliderInput::debounce(uint32_t uNowTime)
 {
-    uint32_t uNowTime = getMillis();
     if ((dDebState != dpadState) && ((uNowTime - uDebTime) > JSLIDER_DEBOUNCE_MILLIS)) {
         if ( (dpadState ^ dDebState) == DPAD_MODE_RIGHT_ANALOG )
             dDebState = (DpadMode)(dDebState ^ DPAD_MODE_RIGHT_ANALOG); // Bounce Right Analog
@@ -49,15 +48,20 @@ void JSliderInput::debounce()
     dpadState = dDebState;
 }
 
-void JSliderInput::process()
+bool JSliderInput::dirty()
+{
+    return read() != dDebState;
+}
+
+void JSliderInput::process(const FrameContext &frame)
 {
     // Get Slider State
     dpadState = read();
 #if JSLIDER_DEBOUNCE_MILLIS > 0
-    debounce();
+    debounce(frame.millis);
 #endif
 
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    Gamepad * gamepad = frame.gamepad;
     if ( gamepad->options.dpadMode != dpadState) {
         gamepad->options.dpadMode = dpadState;
         gamepad->save();
@@ -0,0 +1,320 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "inputs/macro.h"
+
+#include <string.h>
+
+#include "gp2040.h"
+#include "storagemanager.h"
+#include "CRC32.h"
+
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+
+#include "sof_sync.h"
+
+#define MACRO_CHANGE_MAX_BYTES 9  // 5 byte frame count, header, 3 changed bytes
+#define MACRO_SLEW_MICRO       4  // Most a playback frame moves toward the SOF estimate at a time
+#define MACRO_MODIFIER_MASK    (GAMEPAD_MASK_S1 | GAMEPAD_MASK_S2)
+
+static MacroInput *macroInput;
+static uint macroAlarm;
+
+static void __not_in_flash_func(macroIrq)()
+{
+	timer_hw->intr = 1u << macroAlarm;
+	macroInput->step();
+}
+
+static inline uint32_t __attribute__((always_inline)) readFrames(const MacroStorage &macro, uint16_t &cursor)
+{
+	uint32_t frames = 0;
+	for (uint8_t shift = 0; cursor < macro.length && shift < 32; shift += 7)
+	{
+		uint8_t byte = macro.data[cursor++];
+		frames |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			break;
+	}
+
+	return frames;
+}
+
+static inline uint32_t __attribute__((always_inline)) readChange(const MacroStorage &macro, uint16_t &cursor)
+{
+	uint8_t header = macro.data[cursor++];
+	uint32_t change = 0;
+	if (header & MACRO_CHANGED_BUTTONS_LO)
+		change |= macro.data[cursor++];
+	if (header & MACRO_CHANGED_BUTTONS_HI)
+		change |= macro.data[cursor++] << 8;
+	if (header & MACRO_CHANGED_DPAD)
+		change |= macro.data[cursor++] << 16;
+
+	return change;
+}
+
+static inline uint32_t packState(const GamepadState &state)
+{
+	return state.buttons | (state.dpad << 16);
+}
+
+bool MacroInput::available() {
+	return true; // Only needs the hotkeys
+}
+
+void MacroInput::setup()
+{
+	uint8_t pollInterval = Storage::getInstance().getBoardOptionsRef().pollInterval;
+	frameMicros = SOF_FRAME_MICROS * (pollInterval ? pollInterval : 1);
+
+	EEPROM.get(MACRO_STORAGE_INDEX, macro);
+	uint32_t lastCRC = macro.checksum;
+	macro.checksum = CHECKSUM_MAGIC;
+	if (lastCRC != CRC32::calculate(&macro) || macro.length > MACRO_STORAGE_BYTES || macro.frameMicros == 0) {
+		macro.length = 0;
+		macro.frameMicros = frameMicros;
+	}
+
+	alarm = -1; // Claimed on first playback, so its IRQ is on the core running the input loop
+	recording = false;
+	recordArmed = false;
+	playing = false;
+	playbackEnded = false;
+	playState = 0;
+	sofPhase = 0;
+}
+
+bool MacroInput::dirty()
+{
+	return recording || playing || playbackEnded;
+}
+
+void MacroInput::process(const FrameContext &frame)
+{
+	playbackEnded = false; // This frame goes out without the macro's buttons
+
+	if (frame.hotkeys & (1u << HOTKEY_ACTION_MACRO_RECORD)) {
+		if (recording) {
+			stopRecording(frame);
+		} else {
+			stopPlayback();
+			startRecording(frame);
+		}
+	}
+
+	if ((frame.hotkeys & (1u << HOTKEY_ACTION_MACRO_PLAY)) && !recording) {
+		if (playing)
+			stopPlayback();
+		else
+			startPlayback(frame.micros);
+	}
+
+	if (recording)
+		record(frame);
+
+	if (!playing)
+		return;
+
+#if GAMEPAD_CORE_LAYOUT == CORE_LAYOUT_SHARED
+	// SOF timing lives on core0, so it only steers playback when the input loop runs there too
+	if (periodMicros == frameMicros && sof_sync_locked())
+		sofPhase = (uint32_t)sof_sync_next_deadline(frame.micros, GAMEPAD_MACRO_LEAD_MICRO);
+	else
+		sofPhase = 0;
+#endif
+
+	// Played back on top of whatever is held
+	uint32_t state = playState;
+	frame.gamepad->state.buttons |= state;
+	frame.gamepad->state.dpad |= state >> 16;
+}
+
+void MacroInput::startRecording(const FrameContext &frame)
+{
+	recording = true;
+	recordArmed = true;
+	macro.length = 0;
+	macro.frameMicros = frameMicros;
+}
+
+void MacroInput::record(const FrameContext &frame)
+{
+	uint32_t state = packState(frame.current);
+	if (recordArmed) {
+		// Frame 0 is the first frame with nothing held, so the start hotkey doesn't end up in the macro
+		if (state)
+			return;
+
+		recordArmed = false;
+		recordStart = frame.micros;
+		recordFrame = 0;
+		recordState = 0;
+		checkpointLength = 0;
+		checkpointFrame = 0;
+		checkpointState = 0;
+		return;
+	}
+
+	if (state == recordState)
+		return;
+
+	uint32_t frameIndex = (frame.micros - recordStart) / frameMicros;
+	if (!append(frameIndex - recordFrame, state ^ recordState, MACRO_STORAGE_BYTES - MACRO_CHANGE_MAX_BYTES)) {
+		stopRecording(frame); // Full, keep what fits
+		return;
+	}
+
+	recordFrame = frameIndex;
+	recordState = state;
+	if (!(state & MACRO_MODIFIER_MASK)) {
+		checkpointLength = macro.length;
+		checkpointFrame = recordFrame;
+		checkpointState = recordState;
+	}
+}
+
+void MacroInput::stopRecording(const FrameContext &frame)
+{
+	recording = false;
+	if (!recordArmed) {
+		// Cut off the start of the stop hotkey, the macro ends where its modifier went down
+		uint32_t endFrame = (frame.micros - recordStart) / frameMicros;
+		if (recordState & MACRO_MODIFIER_MASK) {
+			endFrame = recordFrame;
+			macro.length = checkpointLength;
+			recordFrame = checkpointFrame;
+			recordState = checkpointState;
+		}
+
+		append(endFrame - recordFrame, recordState, MACRO_STORAGE_BYTES); // Release everything
+	}
+
+	save();
+}
+
+bool MacroInput::append(uint32_t frames, uint32_t change, uint16_t limit)
+{
+	uint8_t encoded[MACRO_CHANGE_MAX_BYTES];
+	uint8_t size = 0;
+	do {
+		uint8_t byte = frames & 0x7F;
+		frames >>= 7;
+		encoded[size++] = byte | (frames ? 0x80 : 0);
+	} while (frames);
+
+	uint8_t &header = encoded[size++];
+	header = 0;
+	if (change & 0x0000FF) {
+		header |= MACRO_CHANGED_BUTTONS_LO;
+		encoded[size++] = change;
+	}
+	if (change & 0x00FF00) {
+		header |= MACRO_CHANGED_BUTTONS_HI;
+		encoded[size++] = change >> 8;
+	}
+	if (change & 0xFF0000) {
+		header |= MACRO_CHANGED_DPAD;
+		encoded[size++] = change >> 16;
+	}
+
+	if (macro.length + size > limit)
+		return false;
+
+	memcpy(&macro.data[macro.length], encoded, size);
+	macro.length += size;
+	return true;
+}
+
+void MacroInput::save()
+{
+	macro.checksum = CHECKSUM_MAGIC;
+	macro.checksum = CRC32::calculate(&macro);
+	EEPROM.set(MACRO_STORAGE_INDEX, macro);
+	EEPROM.commit();
+}
+
+void MacroInput::startPlayback(uint64_t now)
+{
+	if (macro.length == 0)
+		return;
+
+	if (alarm < 0) {
+		alarm = hardware_alarm_claim_unused(true);
+		macroAlarm = alarm;
+		macroInput = this;
+		irq_set_exclusive_handler(TIMER_IRQ_0 + alarm, macroIrq);
+		hw_set_bits(&timer_hw->inte, 1u << alarm);
+		irq_set_enabled(TIMER_IRQ_0 + alarm, true);
+	}
+
+	periodMicros = macro.frameMicros;
+	playCursor = 0;
+	framesUntilChange = readFrames(macro, playCursor);
+	playState = 0;
+	playing = true;
+
+	// Frame 0 starts on the next frame boundary the reports see
+	uint64_t first = now + periodMicros;
+#if GAMEPAD_CORE_LAYOUT == CORE_LAYOUT_SHARED
+	if (periodMicros == frameMicros && sof_sync_locked())
+		first = sof_sync_next_deadline(now, GAMEPAD_MACRO_LEAD_MICRO);
+#endif
+	nextStep = first;
+	timer_hw->alarm[alarm] = nextStep;
+}
+
+void MacroInput::stopPlayback()
+{
+	if (alarm >= 0) {
+		timer_hw->armed = 1u << alarm; // Disarm, and drop one that already fired
+		timer_hw->intr = 1u << alarm;
+	}
+
+	playing = false;
+	playState = 0;
+}
+
+// Every change due this frame, then the alarm for the next one. Targets follow on from the last
+// target, not from now, so IRQ latency doesn't accumulate.
+void __not_in_flash_func(MacroInput::step)()
+{
+	if (!playing)
+		return;
+
+	while (framesUntilChange == 0) {
+		playState ^= readChange(macro, playCursor);
+		if (playCursor >= macro.length) { // The last change releases everything
+			playing = false;
+			playState = 0;
+			playbackEnded = true;
+			return;
+		}
+		framesUntilChange = readFrames(macro, playCursor);
+	}
+	framesUntilChange--;
+
+	uint32_t next = nextStep + periodMicros;
+	uint32_t phase = sofPhase;
+	if (phase) {
+		// Follow the host's frame clock rather than ours, a few us at a time
+		int32_t error = (int32_t)(phase - next) % (int32_t)periodMicros;
+		if (error > (int32_t)periodMicros / 2)
+			error -= periodMicros;
+		else if (error < -(int32_t)periodMicros / 2)
+			error += periodMicros;
+		if (error > MACRO_SLEW_MICRO)
+			error = MACRO_SLEW_MICRO;
+		else if (error < -MACRO_SLEW_MICRO)
+			error = -MACRO_SLEW_MICRO;
+		next += error;
+	}
+
+	if ((int32_t)(next - timer_hw->timerawl) <= 0) // Held off for a whole period, skip ahead
+		next = timer_hw->timerawl + periodMicros;
+	nextStep = next;
+	timer_hw->alarm[alarm] = next;
+}
@@ -28,8 +28,6 @@ void TurboInput::setup()
 
     bDebState = false;
     uDebTime = getMillis();
-    lastPressed = 0;
-    lastDpad = 0;
     buttonsEnabled = 0;
     uIntervalMS = (uint32_t)(1000.0 / boardOptions.turboShotCount);
     bTurboState = false;
@@ -40,13 +38,12 @@ void TurboInput::setup()
 bool TurboInput::read()
 {
     // Get TURBO Key State
-    BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
+    const BoardOptions & boardOptions = Storage::getInstance().getBoardOptionsRef();
     return(!gpio_get(boardOptions.pinButtonTurbo));
 }
 
-void TurboInput::debounce()
+void TurboInput::debounce(uint32_t uNowTime)
 {
-    uint32_t uNowTime = getMillis();
     if ((bDebState != bTurboState) && ((uNowTime - uDebTime) > TURBO_DEBOUNCE_MILLIS)) {
         bDebState ^= true;
         uDebTime = uNowTime;
@@ -54,54 +51,58 @@ void TurboInput::debounce()
     bTurboState = bDebState;
 }
 
-void TurboInput::process()
+void TurboInput::setShotCount(uint8_t shotCount)
 {
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
     BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
-    uint16_t buttonsPressed = gamepad->state.buttons & TURBO_BUTTON_MASK;
-    uint16_t dpadPressed = gamepad->state.dpad & GAMEPAD_MASK_DPAD;
+    boardOptions.turboShotCount = shotCount;
+    Storage::getInstance().setBoardOptions(boardOptions);
+    uIntervalMS = (uint32_t)(1000.0 / shotCount);
+}
+
+bool TurboInput::dirty()
+{
+    // Flicker runs on a timer while an enabled button is held, and the TURBO key is debounced here
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    return (gamepad->rawState.buttons & buttonsEnabled) || (read() != bDebState);
+}
+
+void TurboInput::process(const FrameContext &frame)
+{
+    Gamepad * gamepad = frame.gamepad;
 
     // Get TURBO Button State
     bTurboState = read();
 #if TURBO_DEBOUNCE_MILLIS > 0
-    debounce();
+    debounce(frame.millis);
 #endif
 
     // Set TURBO Enable Buttons 
     if (bTurboState) {
-        if (buttonsPressed && (lastPressed != buttonsPressed)) {
+        uint16_t buttonsPressed = frame.pressed & TURBO_BUTTON_MASK;
+        if (buttonsPressed) {
             buttonsEnabled ^= buttonsPressed; // Toggle Turbo
             // Turn off button once turbo is toggled
             gamepad->state.buttons &= ~(TURBO_BUTTON_MASK);
         }
-        if (dpadPressed & GAMEPAD_MASK_DOWN && (lastDpad != dpadPressed)) {
-            if ( boardOptions.turboShotCount > TURBO_SHOT_MIN ) { // can't go lower than 2-shots per second
-                boardOptions.turboShotCount--;
-                Storage::getInstance().setBoardOptions(boardOptions);
-                uIntervalMS = (uint32_t)(1000.0 / boardOptions.turboShotCount);
+        uint8_t shotCount = frame.boardOptions.turboShotCount;
+        if (frame.dpadPressed & GAMEPAD_MASK_DOWN) {
+            if ( shotCount > TURBO_SHOT_MIN ) { // can't go lower than 2-shots per second
+                setShotCount(shotCount - 1);
             }
-        } else if ( dpadPressed & GAMEPAD_MASK_UP && (lastDpad != dpadPressed)) {
-            if ( boardOptions.turboShotCount < TURBO_SHOT_MAX ) { // can't go higher than 60-shots per second
-                boardOptions.turboShotCount++;
-                Storage::getInstance().setBoardOptions(boardOptions);
-                uIntervalMS = (uint32_t)(1000.0 / boardOptions.turboShotCount);
+        } else if (frame.dpadPressed & GAMEPAD_MASK_UP) {
+            if ( shotCount < TURBO_SHOT_MAX ) { // can't go higher than 60-shots per second
+                setShotCount(shotCount + 1);
             }
         }
-        lastPressed = buttonsPressed; // save last pressed
-        lastDpad = dpadPressed;
         return; // Holding TURBO cancels turbo functionality
-    } else {
-        lastPressed = 0; // disable last pressed
-        lastDpad = 0; // disable last dpad
     }
 
-
     // Set TURBO LED if a button is going or turbo is too fast
-    if ( boardOptions.pinTurboLED != -1 ) {
+    if ( frame.boardOptions.pinTurboLED != -1 ) {
         if ((gamepad->state.buttons & buttonsEnabled) && !bTurboFlicker) {
-            gpio_put(boardOptions.pinTurboLED, 0);
+            gpio_put(frame.boardOptions.pinTurboLED, 0);
         } else {
-            gpio_put(boardOptions.pinTurboLED, 1);
+            gpio_put(frame.boardOptions.pinTurboLED, 1);
         }	
     }
 
@@ -110,10 +111,10 @@ void TurboInput::process()
         gamepad->state.buttons &= ~(buttonsEnabled);
     }
 
-    if (getMillis() < nextTimer) {
+    if (frame.millis < nextTimer) {
         return; // don't flip if we haven't reached the next timer
     }
 
     bTurboFlicker ^= true; // Button ON/OFF State Reverse
-    nextTimer = getMillis() + uIntervalMS; // interval to flicker-off button
+    nextTimer = frame.millis + uIntervalMS; // interval to flicker-off button
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "inputtrace.h"
+
+#include "pico/platform.h"
+
+// Left alone by the C runtime at startup, so it outlives a watchdog reboot (but not a power cycle)
+static InputTraceRing __uninitialized_ram(inputTraceRing);
+
+InputTrace::InputTrace() : ring(inputTraceRing) {}
+
+void InputTrace::setup(bool clear)
+{
+	if (clear || ring.magic != INPUT_TRACE_MAGIC)
+	{
+		ring.magic = INPUT_TRACE_MAGIC;
+		ring.head = 0;
+	}
+}
+
+const InputTraceRecord & InputTrace::getRecord(uint32_t index)
+{
+	return ring.records[(ring.head - getCount() + index) & (GAMEPAD_INPUT_TRACE_RECORDS - 1)];
+}
@@ -9,11 +9,19 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "gp2040aux.h"
+#include "bootstats.h"
+
+static GP2040 * gp2040;
 
 // Launch our second core with additional modules loaded in
 void core1() {
 	multicore_lockout_victim_init(); // block core 1
 
+	if (gp2040->inputCoreLayout()) {
+		gp2040->runInputCore(); // Inputs only, core0 has the addons
+		return;
+	}
+
 	// Create GP2040 w/ Additional Modules for Core 1
 	GP2040Aux * gp2040Core1 = new GP2040Aux();
 	gp2040Core1->setup();
@@ -21,10 +29,19 @@ void core1() {
 }
 
 int main() {
+	BootStats::getInstance().mark(BOOT_STAGE_MAIN);
+
 	// Create GP2040 Main Core (core0), Core1 is dependent on Core0
-	GP2040 * gp2040 = new GP2040();
+	gp2040 = new GP2040();
 	gp2040->setup();
 
+	if (gp2040->inputCoreLayout()) {
+		// Core1 saves options from hotkeys in this layout, so core0 has to be lockable too
+		multicore_lockout_victim_init();
+		GP2040Aux * gp2040Aux = new GP2040Aux();
+		gp2040Aux->setup();
+	}
+
 	// Create GP2040 Thread for Core1
 	multicore_launch_core1(core1);
 
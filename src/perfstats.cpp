@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "perfstats.h"
+
+#include <string.h>
+
+#include "hardware/clocks.h"
+#include "LogBins.h"
+
+static const char * const builtinStages[PERF_STAGE_INPUTS] =
+{
+	"read",
+	"debounce",
+	"hotkey",
+	"process",
+	"publish",
+	"send_report",
+	"receive_report",
+	"tud_task",
+	"report_age",
+};
+
+uint32_t PerfStageStats::percentile(uint8_t percent) const
+{
+	return logBinPercentile(bins, PERF_HISTOGRAM_BINS, binTotal, percent);
+}
+
+void PerfStats::setup()
+{
+	setupCore();
+	cyclesPerMicro = clock_get_hz(clk_sys) / 1000000;
+	reset();
+	stageCount = 0;
+	for (uint8_t i = 0; i < PERF_STAGE_INPUTS; i++)
+		addStage(builtinStages[i]);
+}
+
+void PerfStats::setupCore()
+{
+	// Free-running 24-bit down counter on the processor clock, no interrupt
+	systick_hw->rvr = 0x00FFFFFF;
+	systick_hw->cvr = 0;
+	systick_hw->csr = 0x5;
+}
+
+void PerfStats::recordMicros(uint8_t stage, uint32_t micros)
+{
+	uint64_t cycles = (uint64_t)micros * cyclesPerMicro;
+	record(stage, cycles > UINT32_MAX ? UINT32_MAX : cycles);
+}
+
+uint8_t PerfStats::addStage(const std::string &name)
+{
+	if (stageCount >= PERF_MAX_STAGES)
+		return PERF_MAX_STAGES - 1; // Out of slots, share the last one
+
+	stages[stageCount].name = name;
+	return stageCount++;
+}
+
+void PerfStats::reset()
+{
+	for (uint8_t i = 0; i < PERF_MAX_STAGES; i++)
+	{
+		PerfStageStats &stats = stages[i];
+		stats.count = 0;
+		stats.minCycles = UINT32_MAX;
+		stats.maxCycles = 0;
+		stats.totalCycles = 0;
+		stats.binTotal = 0;
+		memset(stats.bins, 0, sizeof(stats.bins));
+	}
+}
+
+void PerfStats::record(uint8_t stage, uint32_t cycles)
+{
+	if (stage >= PERF_MAX_STAGES)
+		stage = PERF_MAX_STAGES - 1;
+
+	PerfStageStats &stats = stages[stage];
+	if (stats.count == 0 || cycles < stats.minCycles)
+		stats.minCycles = cycles;
+	if (cycles > stats.maxCycles)
+		stats.maxCycles = cycles;
+
+	stats.count++;
+	stats.totalCycles += cycles;
+
+	// Halve the histogram when a bin would overflow, older samples fade out
+	uint8_t bin = logBinFor(cycles, PERF_HISTOGRAM_BINS); // recordMicros() spans can run past the last bin
+	if (stats.bins[bin] == UINT16_MAX)
+	{
+		stats.binTotal = 0;
+		for (uint8_t i = 0; i < PERF_HISTOGRAM_BINS; i++)
+		{
+			stats.bins[i] >>= 1;
+			stats.binTotal += stats.bins[i];
+		}
+	}
+
+	stats.bins[bin]++;
+	stats.binTotal++;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "piosampler.h"
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/pio.h"
+
+#include "piosampler.pio.h"
+
+#define PIO_SAMPLE_PERIOD_NANOS (1000000000 / GAMEPAD_PIO_SAMPLE_HZ)
+#define PIO_SAMPLE_RING_MICROS  ((uint32_t)(((uint64_t)PIO_SAMPLE_RING_SIZE * 1000000) / GAMEPAD_PIO_SAMPLE_HZ))
+
+void PioSampler::setup()
+{
+	// pio0 is left to the LED addons
+	PIO pio = pio1;
+	uint sm = pio_claim_unused_sm(pio, true);
+	uint offset = pio_add_program(pio, &piosampler_program);
+	piosampler_program_init(pio, sm, offset, GAMEPAD_PIO_SAMPLE_HZ);
+
+	dataChannel = dma_claim_unused_channel(true);
+	controlChannel = dma_claim_unused_channel(true);
+	ringStart = ring;
+
+	dma_channel_config dataConfig = dma_channel_get_default_config(dataChannel);
+	channel_config_set_transfer_data_size(&dataConfig, DMA_SIZE_32);
+	channel_config_set_read_increment(&dataConfig, false);
+	channel_config_set_write_increment(&dataConfig, true);
+	channel_config_set_dreq(&dataConfig, pio_get_dreq(pio, sm, false));
+	channel_config_set_chain_to(&dataConfig, controlChannel);
+	dma_channel_configure(dataChannel, &dataConfig, ring, &pio->rxf[sm], PIO_SAMPLE_RING_SIZE, false);
+
+	// Writes the ring start back to the data channel's write address trigger, restarting it with the same count
+	dma_channel_config controlConfig = dma_channel_get_default_config(controlChannel);
+	channel_config_set_transfer_data_size(&controlConfig, DMA_SIZE_32);
+	channel_config_set_read_increment(&controlConfig, false);
+	channel_config_set_write_increment(&controlConfig, false);
+	dma_channel_configure(controlChannel, &controlConfig, &dma_hw->ch[dataChannel].al2_write_addr_trig, &ringStart, 1, false);
+
+	lastSample = ~gpio_get_all();
+	dma_channel_start(dataChannel);
+	pio_sm_set_enabled(pio, sm, true);
+
+	readIndex = peekIndex = writeIndex();
+	readMicros = time_us_32();
+}
+
+// Next slot the DMA will fill. Between the end of the ring and the restart the address is one past the end, which wraps to 0.
+inline uint32_t PioSampler::writeIndex()
+{
+	return ((dma_hw->ch[dataChannel].write_addr - (uint32_t)ring) / sizeof(uint32_t)) & (PIO_SAMPLE_RING_SIZE - 1);
+}
+
+uint32_t PioSampler::read(uint32_t pinMask, uint32_t *edgeMicros)
+{
+	uint32_t now = time_us_32();
+	uint32_t end = writeIndex();
+	uint32_t count = (end - readIndex) & (PIO_SAMPLE_RING_SIZE - 1);
+
+	// The DMA has written a whole ring since readIndex, so it's been overwritten
+	if ((now - readMicros) >= PIO_SAMPLE_RING_MICROS)
+	{
+		// Unread samples were overwritten, only the newest one is worth anything
+		overruns++;
+		readIndex = (end - 1) & (PIO_SAMPLE_RING_SIZE - 1);
+		count = 1;
+	}
+
+	uint32_t previous = lastSample & pinMask;
+	uint32_t pressed = previous;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t sample = ~ring[(readIndex + i) & (PIO_SAMPLE_RING_SIZE - 1)] & pinMask;
+		uint32_t changes = sample ^ previous;
+		if (changes)
+		{
+			// Sample times count back from now, the newest sample is at most a FIFO's depth old
+			uint32_t sampleMicros = now - (((count - 1 - i) * PIO_SAMPLE_PERIOD_NANOS) / 1000);
+			for (; changes; changes &= changes - 1)
+				edgeMicros[__builtin_ctz(changes)] = sampleMicros;
+		}
+		pressed |= sample;
+		previous = sample;
+	}
+
+	if (count > 0)
+		lastSample = ~ring[(readIndex + count - 1) & (PIO_SAMPLE_RING_SIZE - 1)];
+	readIndex = peekIndex = end;
+	readMicros = now;
+
+	// A pin pressed and released since the last read shows as pressed for this frame, the debouncer releases it after
+	return pressed;
+}
+
+bool PioSampler::changed(uint32_t pinMask)
+{
+	uint32_t end = writeIndex();
+	uint32_t reference = ~lastSample & pinMask;
+	for (; peekIndex != end; peekIndex = (peekIndex + 1) & (PIO_SAMPLE_RING_SIZE - 1))
+	{
+		if ((ring[peekIndex] & pinMask) != reference)
+			break;
+	}
+
+	// Everything before peekIndex holds the last level, read() has nothing to learn from it. Past a whole ring
+	// the scan may have met overwritten samples, that's left for read() to count.
+	uint32_t now = time_us_32();
+	if (peekIndex != readIndex && (now - readMicros) < PIO_SAMPLE_RING_MICROS)
+	{
+		uint32_t pending = (end - peekIndex) & (PIO_SAMPLE_RING_SIZE - 1);
+		lastSample = ~ring[(peekIndex - 1) & (PIO_SAMPLE_RING_SIZE - 1)];
+		readIndex = peekIndex;
+		readMicros = now - ((pending * PIO_SAMPLE_PERIOD_NANOS) / 1000);
+	}
+
+	return peekIndex != end;
+}
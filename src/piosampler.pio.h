@@ -0,0 +1,46 @@
+// -------------------------------------------------- //
+// This file is autogenerated by pioasm; do not edit! //
+// -------------------------------------------------- //
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+// ---------- //
+// piosampler //
+// ---------- //
+
+#define piosampler_wrap_target 0
+#define piosampler_wrap 0
+
+static const uint16_t piosampler_program_instructions[] = {
+            //     .wrap_target
+    0x4000, //  0: in     pins, 32                   
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program piosampler_program = {
+    .instructions = piosampler_program_instructions,
+    .length = 1,
+    .origin = -1,
+};
+
+static inline pio_sm_config piosampler_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + piosampler_wrap_target, offset + piosampler_wrap);
+    return c;
+}
+
+#include "hardware/clocks.h"
+static inline void piosampler_program_init(PIO pio, uint sm, uint offset, float freq) {
+    pio_sm_config c = piosampler_program_get_default_config(offset);
+    sm_config_set_in_pins(&c, 0);
+    sm_config_set_in_shift(&c, false, true, 32);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv(&c, clock_get_hz(clk_sys) / freq);
+    pio_sm_init(pio, sm, offset, &c);
+}
+
+#endif
+
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "scheduler.h"
+#include "gpaddon.h"
+#include "eventbus.h"
+#include "storagemanager.h"
+
+#include "hardware/sync.h"
+
+#define SCHEDULER_MAX_SLEEP_MICROS 10000 // Wake now and then even with nothing due
+
+void Scheduler::setup(std::vector<GPAddon*> &addons)
+{
+	uint32_t now = time_us_32();
+	for (GPAddon *addon : addons)
+	{
+		if (taskCount >= SCHEDULER_MAX_TASKS)
+			break;
+
+		SchedulerTask &task = tasks[taskCount++];
+		task = {};
+		task.addon = addon;
+		task.schedule = addon->schedule();
+		task.nextRun = now;
+	}
+}
+
+void Scheduler::run()
+{
+	while (1) {
+		int32_t waitMicros = poll();
+		if (waitMicros == 0)
+			continue;
+
+		if (waitMicros > SCHEDULER_MAX_SLEEP_MICROS)
+			waitMicros = SCHEDULER_MAX_SLEEP_MICROS;
+		if (EventBus::getInstance().empty())
+			sleepUntil(time_us_64() + waitMicros);
+	}
+}
+
+int32_t Scheduler::poll()
+{
+	// Input state and events are refreshed before every task, so each one works on the latest data
+	Storage::getInstance().SyncSnapshot();
+	EventBus::getInstance().dispatch();
+
+	uint32_t now = time_us_32();
+	int32_t waitMicros;
+	SchedulerTask *task = nextDue(now, waitMicros);
+	if (task == nullptr)
+		return waitMicros;
+
+	runTask(*task, now);
+	return 0;
+}
+
+void Scheduler::sleepUntil(uint64_t micros)
+{
+	best_effort_wfe_or_timeout(from_us_since_boot(micros));
+}
+
+// Highest priority task that's due (earliest deadline breaks ties), or how long until the next one is
+SchedulerTask *Scheduler::nextDue(uint32_t now, int32_t &waitMicros)
+{
+	SchedulerTask *due = nullptr;
+	waitMicros = INT32_MAX;
+	for (uint8_t i = 0; i < taskCount; i++)
+	{
+		SchedulerTask &task = tasks[i];
+		int32_t untilDue = (int32_t)(task.nextRun - now);
+		if (untilDue > 0) {
+			if (untilDue < waitMicros)
+				waitMicros = untilDue;
+			continue;
+		}
+
+		if (due == nullptr
+			|| task.schedule.priority < due->schedule.priority
+			|| (task.schedule.priority == due->schedule.priority && (int32_t)(task.nextRun - due->nextRun) < 0))
+			due = &task;
+	}
+
+	return due;
+}
+
+void Scheduler::runTask(SchedulerTask &task, uint32_t now)
+{
+	task.addon->process();
+	uint32_t elapsed = time_us_32() - now;
+
+	task.runs++;
+	task.totalMicros += elapsed;
+	if (elapsed > task.maxMicros)
+		task.maxMicros = elapsed;
+	if (task.schedule.budgetMicros && elapsed > task.schedule.budgetMicros)
+		task.overruns++;
+
+	// Keep the period phase-locked, unless we've fallen a whole period behind
+	uint32_t period = task.schedule.periodMicros;
+	task.nextRun += period;
+	if (period == 0 || (int32_t)(task.nextRun - now) <= 0) {
+		if (period != 0)
+			task.misses++;
+		task.nextRun = now + period;
+	}
+}
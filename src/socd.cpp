@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "socd.h"
+
+static void axisRules(uint8_t mode, SOCDAxisRule &vertical, SOCDAxisRule &horizontal)
+{
+	switch (mode)
+	{
+		case SOCD_MODE_UP_PRIORITY:
+			vertical = SOCD_AXIS_NEGATIVE;
+			horizontal = SOCD_AXIS_NEUTRAL;
+			break;
+
+		case SOCD_MODE_SECOND_INPUT_PRIORITY:
+			vertical = SOCD_AXIS_LAST_INPUT;
+			horizontal = SOCD_AXIS_LAST_INPUT;
+			break;
+
+		case SOCD_MODE_FIRST_INPUT_PRIORITY:
+			vertical = SOCD_AXIS_FIRST_INPUT;
+			horizontal = SOCD_AXIS_FIRST_INPUT;
+			break;
+
+		case SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL:
+			vertical = SOCD_AXIS_NEGATIVE;
+			horizontal = SOCD_AXIS_LAST_INPUT;
+			break;
+
+		case SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL:
+			vertical = SOCD_AXIS_LAST_INPUT;
+			horizontal = SOCD_AXIS_NEUTRAL;
+			break;
+
+		default: // SOCD_MODE_NEUTRAL, and anything unknown like MPGS does
+			vertical = SOCD_AXIS_NEUTRAL;
+			horizontal = SOCD_AXIS_NEUTRAL;
+			break;
+	}
+}
+
+// Directions of one axis that survive the rule
+static uint8_t resolveAxis(uint8_t dpad, uint8_t negative, uint8_t positive, SOCDAxisRule rule, bool positiveLast)
+{
+	uint8_t held = dpad & (negative | positive);
+	if (held != (negative | positive))
+		return held;
+
+	switch (rule)
+	{
+		case SOCD_AXIS_NEGATIVE:    return negative;
+		case SOCD_AXIS_POSITIVE:    return positive;
+		case SOCD_AXIS_LAST_INPUT:  return positiveLast ? positive : negative;
+		case SOCD_AXIS_FIRST_INPUT: return positiveLast ? negative : positive;
+		default:                    return 0;
+	}
+}
+
+SOCDCleaner::SOCDCleaner()
+{
+	setMode(SOCD_MODE_NEUTRAL);
+}
+
+void SOCDCleaner::setMode(uint8_t newMode)
+{
+	SOCDAxisRule vertical, horizontal;
+	axisRules(newMode, vertical, horizontal);
+
+	for (uint8_t index = 0; index < sizeof(table); index++)
+	{
+		uint8_t dpad = index & 0x0F;
+		table[index] = resolveAxis(dpad, GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, vertical, index & 0x10)
+			| resolveAxis(dpad, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT, horizontal, index & 0x20);
+	}
+
+	mode = newMode;
+}
@@ -75,6 +75,16 @@ void Storage::setDefaultBoardOptions()
 	boardOptions.displayInvert     = DISPLAY_INVERT;
 	boardOptions.turboShotCount    = DEFAULT_SHOT_PER_SEC;
 	boardOptions.pinTurboLED       = TURBO_LED_PIN;
+	boardOptions.pollInterval      = GAMEPAD_POLL_INTERVAL;
+	boardOptions.debounceMode      = GAMEPAD_DEBOUNCE_MODE;
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		boardOptions.debounceMicros[i] = GAMEPAD_DEBOUNCE_MICROS;
+	for (int profile = 0; profile < GAMEPAD_REMAP_PROFILES; profile++)
+	{
+		for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+			boardOptions.remapProfiles[profile][i] = i;
+	}
+	boardOptions.remapProfile      = 0;
 	strncpy(boardOptions.boardVersion, GP2040VERSION, strlen(GP2040VERSION));
 	setBoardOptions(boardOptions);
 }
@@ -198,6 +208,58 @@ uint8_t * Storage::GetFeatureData()
 	return featureData;
 }
 
+void Storage::PublishGamepadState(Gamepad *gamepad, uint32_t micros)
+{
+	const GamepadState &state = gamepad->state;
+	if (!memcmp(&published.state, &state, sizeof(GamepadState)))
+		return;
+
+	uint16_t previousButtons = published.state.buttons;
+	uint8_t previousDpad = published.state.dpad;
+	memcpy(&published.state, &state, sizeof(GamepadState));
+	published.micros = micros;
+	published.gpio = gamepad->rawGpio;
+	if (gamepad->debouncer.pressed) // A press that changed nothing is left out
+		published.pressMicros = gamepad->debouncer.pressMicros;
+	snapshot.write(published);
+
+	// Edges also go out as an event, after the snapshot so a subscriber never sees an event ahead of the state
+	if (state.buttons != previousButtons || state.dpad != previousDpad)
+	{
+		GamepadEvent event;
+		event.type = EVENT_INPUT;
+		event.input.buttons      = state.buttons;
+		event.input.pressed      = state.buttons & ~previousButtons;
+		event.input.released     = previousButtons & ~state.buttons;
+		event.input.dpad         = state.dpad;
+		event.input.dpadPressed  = state.dpad & ~previousDpad;
+		event.input.dpadReleased = previousDpad & ~state.dpad;
+		EventBus::getInstance().publish(event);
+	}
+}
+
+void Storage::PublishFeatureData()
+{
+	if (!memcmp(publishedFeatureData, featureData, sizeof(featureData)))
+		return;
+
+	memcpy(publishedFeatureData, featureData, sizeof(featureData));
+	GamepadEvent event;
+	event.type = EVENT_USB_OUT_REPORT;
+	memcpy(event.data, featureData, sizeof(featureData));
+	EventBus::getInstance().publish(event);
+}
+
+uint32_t Storage::SyncSnapshot()
+{
+	if (snapshot.version() == syncedVersion) // Skip the copy too
+		return syncedVersion;
+
+	syncedVersion = snapshot.read(synced);
+	memcpy(&processedGamepad->state, &synced.state, sizeof(GamepadState));
+	return syncedVersion;
+}
+
 /* Animation stuffs */
 AnimationOptions AnimationStorage::getAnimationOptions()
 {
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "switchstats.h"
+#include "storagemanager.h"
+
+#include <string.h>
+
+#include "pico/platform.h"
+#include "hardware/timer.h"
+#include "FlashPROM.h"
+#include "CRC32.h"
+#include "LogBins.h"
+
+// Not zeroed at startup, setup() only reloads the lifetime counters from flash after a cold boot
+static SwitchStatsStore __uninitialized_ram(switchStatsStore);
+
+SwitchStats::SwitchStats() : store(switchStatsStore), lastRaw(0), lastEdgeMicros(0), nextCheckpoint(0), dirty(false) {}
+
+void SwitchStats::setup(bool configMode)
+{
+	if (store.magic != SWITCH_STATS_MAGIC)
+	{
+		// Cold boot, the lifetime counters come back from flash
+		SwitchStatsStorage saved;
+		EEPROM.get(SWITCH_STATS_STORAGE_INDEX, saved);
+		uint32_t lastCRC = saved.checksum;
+		saved.checksum = CHECKSUM_MAGIC;
+		bool valid = lastCRC == CRC32::calculate(&saved);
+
+		memset(&store, 0, sizeof(store));
+		store.magic = SWITCH_STATS_MAGIC;
+		for (uint8_t pin = 0; valid && pin < NUM_BANK0_GPIOS; pin++)
+			store.pins[pin].counters = saved.pins[pin].counters;
+	}
+
+	for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+	{
+		if (configMode) // Nothing is moving in web config, close out what the last boot left open
+			finish(store.pins[pin]);
+		store.pins[pin].burstEdges = 0;
+	}
+
+	lastRaw = 0;
+	dirty = configMode; // Web config is a safe time to write out what the gamepad boot counted
+	lastEdgeMicros = time_us_32() - SWITCH_STATS_IDLE_MICROS;
+	nextCheckpoint = configMode ? 0 : time_us_64() + GAMEPAD_SWITCH_STATS_CHECKPOINT_MINUTES * 60000000ull;
+}
+
+void SwitchStats::edge(uint8_t pin, uint32_t micros)
+{
+	SwitchPinStats &stats = store.pins[pin];
+	lastEdgeMicros = micros;
+	dirty = true;
+
+	if (stats.burstEdges && (micros - stats.burstLast) < GAMEPAD_BOUNCE_WINDOW_MICROS)
+	{
+		if (stats.burstEdges < UINT8_MAX)
+			stats.burstEdges++;
+		stats.burstLast = micros;
+		return;
+	}
+
+	finish(stats);
+	stats.burstStart = micros;
+	stats.burstLast = micros;
+	stats.burstEdges = 1;
+}
+
+void SwitchStats::finish(SwitchPinStats &stats)
+{
+	if (stats.burstEdges > 1)
+	{
+		if (stats.burstEdges & 1) // Settled on the other level
+		{
+			uint32_t micros = stats.burstLast - stats.burstStart;
+			uint8_t bin = logBinFor(micros, SWITCH_STATS_BINS);
+			stats.counters.bounces++;
+			if (stats.bounceBins[bin] < UINT16_MAX)
+				stats.bounceBins[bin]++;
+			if (micros > stats.maxBounceMicros)
+				stats.maxBounceMicros = micros;
+		}
+		else // Back where it started
+		{
+			stats.counters.chatters++;
+		}
+	}
+
+	stats.burstEdges = 0;
+}
+
+void SwitchStats::save(uint64_t nowMicros)
+{
+	// Flash writes stall the inputs, so only once nobody is playing
+	uint32_t now = nowMicros;
+	if ((now - lastEdgeMicros) < SWITCH_STATS_IDLE_MICROS)
+	{
+		nextCheckpoint = nowMicros + SWITCH_STATS_RETRY_MICROS;
+		return;
+	}
+
+	nextCheckpoint = nowMicros + GAMEPAD_SWITCH_STATS_CHECKPOINT_MINUTES * 60000000ull;
+	if (!dirty)
+		return;
+
+	SwitchStatsStorage saved;
+	for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+	{
+		if ((now - store.pins[pin].burstLast) >= GAMEPAD_BOUNCE_WINDOW_MICROS)
+			finish(store.pins[pin]);
+		saved.pins[pin] = store.pins[pin].counters;
+	}
+
+	saved.checksum = CHECKSUM_MAGIC;
+	saved.checksum = CRC32::calculate(&saved);
+	EEPROM.set(SWITCH_STATS_STORAGE_INDEX, saved);
+	EEPROM.commit();
+	dirty = false;
+}
+
+uint32_t SwitchStats::percentile(uint8_t pin, uint8_t percent)
+{
+	const SwitchPinStats &stats = store.pins[pin];
+	uint32_t total = 0; // Saturated bins don't add up to bounces, count what's there
+	for (uint8_t bin = 0; bin < SWITCH_STATS_BINS; bin++)
+		total += stats.bounceBins[bin];
+
+	return logBinPercentile(stats.bounceBins, SWITCH_STATS_BINS, total, percent);
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// Input addon dispatch: AddonPipeline's direct calls against the vector<GPAddon*> virtual loop it replaced,
+// with 3 and 10 addons. Addon bodies are kept out of line on both paths, as they are in their own .cpp files.
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// gpaddon.h, bootstats.h and perfstats.h need the whole firmware, these are the parts AddonPipeline uses
+#define _GPAddon_H_
+#define _BOOTSTATS_H_
+#define _PERFSTATS_H_
+#define GAMEPAD_PERF_STATS 0
+#define PERF_END(stage)
+
+struct FrameContext
+{
+	uint64_t micros;
+	uint16_t held;
+	uint16_t pressed;
+};
+
+class GPAddon
+{
+public:
+	virtual ~GPAddon() {}
+	virtual bool available() = 0;
+	virtual void setup() = 0;
+	virtual void process() {}
+	virtual void process(const FrameContext &) { process(); }
+	virtual std::string name() = 0;
+	virtual bool dirty() { return true; }
+};
+
+struct BootStats
+{
+	static BootStats& getInstance() { static BootStats instance; return instance; }
+	void addonSetup(const std::string &, uint32_t) {}
+};
+
+static inline uint32_t time_us_32() { return 0; }
+
+#include "addonpipeline.h"
+
+#define BENCH_FRAMES 2000000
+#define BENCH_RUNS   5
+
+// Turbo-sized work: look at the frame, keep a little state
+template <int N>
+class BenchAddon : public GPAddon
+{
+public:
+	virtual bool available() { return true; }
+	virtual void setup() { count = 0; }
+	virtual void __attribute__((noinline)) process(const FrameContext &frame)
+	{
+		count += ((frame.held >> N) & 1) * (frame.micros & 0xFF); // No branch on the input, so only dispatch differs
+		count ^= frame.pressed;
+	}
+	virtual std::string name() { return "Bench" + std::to_string(N); }
+	uint32_t count;
+};
+
+typedef AddonPipeline<BenchAddon<0>, BenchAddon<1>, BenchAddon<2>> Pipeline3;
+typedef AddonPipeline<BenchAddon<0>, BenchAddon<1>, BenchAddon<2>, BenchAddon<3>, BenchAddon<4>,
+	BenchAddon<5>, BenchAddon<6>, BenchAddon<7>, BenchAddon<8>, BenchAddon<9>> Pipeline10;
+
+static FrameContext frameFor(uint32_t i)
+{
+	return { (uint64_t)i * 1000, (uint16_t)(i * 2654435761u >> 16), (uint16_t)(i & 0x3) };
+}
+
+template <typename Pipeline>
+static double benchStatic()
+{
+	Pipeline pipeline;
+	std::vector<GPAddon*> registry;
+	pipeline.setup(registry);
+
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < BENCH_FRAMES; i++)
+			pipeline.process(frameFor(i));
+		auto end = std::chrono::steady_clock::now();
+		double nanos = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_FRAMES;
+		if (run == 0 || nanos < best)
+			best = nanos;
+	}
+
+	return best;
+}
+
+// The GAMEPAD_STATIC_ADDONS=0 loop in GP2040::processInputs(), on the pipeline's own addons
+template <typename Pipeline>
+static double benchDynamic()
+{
+	Pipeline pipeline;
+	std::vector<GPAddon*> inputs;
+	pipeline.setup(inputs);
+
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < BENCH_FRAMES; i++)
+		{
+			FrameContext frame = frameFor(i);
+			for (uint8_t a = 0; a < inputs.size(); a++)
+				inputs[a]->process(frame);
+		}
+		auto end = std::chrono::steady_clock::now();
+		double nanos = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_FRAMES;
+		if (run == 0 || nanos < best)
+			best = nanos;
+	}
+
+	return best;
+}
+
+int main()
+{
+	double static3 = benchStatic<Pipeline3>();
+	double dynamic3 = benchDynamic<Pipeline3>();
+	double static10 = benchStatic<Pipeline10>();
+	double dynamic10 = benchDynamic<Pipeline10>();
+
+	printf("addon dispatch, ns per frame (best of %d, %d frames)\n", BENCH_RUNS, BENCH_FRAMES);
+	printf("            static  dynamic\n");
+	printf("  3 addons  %6.2f  %6.2f  (%.2fx)\n", static3, dynamic3, dynamic3 / static3);
+	printf("  10 addons %6.2f  %6.2f  (%.2fx)\n", static10, dynamic10, dynamic10 / static10);
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// GPIO word to buttons/dpad: the per-button ternary read() this replaced, the byte-sliced tables and the
+// GAMEPAD_STATIC_PINS fold, on the Pico BoardConfig.h pins. Host timings, the ratios are what matter.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include <MPGS.h>
+
+// Same packing as gamepad.h, which needs the whole MPG library to include
+#define GAMEPAD_LUT_COUNT      4
+#define GAMEPAD_LUT_DPAD_SHIFT 16
+#define GAMEPAD_LUT_AUX_SHIFT  20
+
+#define GAMEPAD_STATIC_PINS 1 // Timed whatever the firmware default is
+#include "staticpins.h"
+
+#define BENCH_WORDS  4096
+#define BENCH_PASSES 2000
+#define BENCH_RUNS   5
+
+struct Mapping
+{
+	uint8_t pin;
+	uint32_t pinMask;
+	uint16_t buttonMask;
+};
+
+struct Options
+{
+	bool invertYAxis;
+};
+
+static Mapping *mappings[GAMEPAD_DIGITAL_INPUT_COUNT];
+static Options options;
+static uint32_t (*pinLUT)[256];
+
+// Gamepad::read() before the tables, one test and select per button through the mapping pointers
+static uint32_t __attribute__((noinline)) ternaryTranslate(uint32_t values)
+{
+	Mapping *mapDpadUp = mappings[0], *mapDpadDown = mappings[1], *mapDpadLeft = mappings[2], *mapDpadRight = mappings[3];
+	uint32_t dpad = 0
+		| ((values & mapDpadUp->pinMask)    ? (options.invertYAxis ? mapDpadDown->buttonMask : mapDpadUp->buttonMask) : 0)
+		| ((values & mapDpadDown->pinMask)  ? (options.invertYAxis ? mapDpadUp->buttonMask : mapDpadDown->buttonMask) : 0)
+		| ((values & mapDpadLeft->pinMask)  ? mapDpadLeft->buttonMask  : 0)
+		| ((values & mapDpadRight->pinMask) ? mapDpadRight->buttonMask : 0)
+	;
+
+	uint32_t buttons = 0
+		| ((values & mappings[4]->pinMask)  ? mappings[4]->buttonMask  : 0)
+		| ((values & mappings[5]->pinMask)  ? mappings[5]->buttonMask  : 0)
+		| ((values & mappings[6]->pinMask)  ? mappings[6]->buttonMask  : 0)
+		| ((values & mappings[7]->pinMask)  ? mappings[7]->buttonMask  : 0)
+		| ((values & mappings[8]->pinMask)  ? mappings[8]->buttonMask  : 0)
+		| ((values & mappings[9]->pinMask)  ? mappings[9]->buttonMask  : 0)
+		| ((values & mappings[10]->pinMask) ? mappings[10]->buttonMask : 0)
+		| ((values & mappings[11]->pinMask) ? mappings[11]->buttonMask : 0)
+		| ((values & mappings[12]->pinMask) ? mappings[12]->buttonMask : 0)
+		| ((values & mappings[13]->pinMask) ? mappings[13]->buttonMask : 0)
+		| ((values & mappings[14]->pinMask) ? mappings[14]->buttonMask : 0)
+		| ((values & mappings[15]->pinMask) ? mappings[15]->buttonMask : 0)
+		| ((values & mappings[16]->pinMask) ? mappings[16]->buttonMask : 0)
+		| ((values & mappings[17]->pinMask) ? mappings[17]->buttonMask : 0)
+	;
+
+	return buttons | (dpad << GAMEPAD_LUT_DPAD_SHIFT);
+}
+
+static uint32_t __attribute__((noinline)) lutTranslate(uint32_t values)
+{
+	return pinLUT[0][values & 0xFF]
+		| pinLUT[1][(values >> 8) & 0xFF]
+		| pinLUT[2][(values >> 16) & 0xFF]
+		| pinLUT[3][(values >> 24) & 0xFF];
+}
+
+static uint32_t __attribute__((noinline)) staticPinsTranslate(uint32_t values)
+{
+	return options.invertYAxis ? staticTranslate<true>(values) : staticTranslate<false>(values);
+}
+
+// As Gamepad::updateMappings(), without a remap profile
+static void buildTables()
+{
+	uint32_t pinOutputs[32] = { };
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		int target = (options.invertYAxis && i < 2) ? (i ^ 1) : i;
+		pinOutputs[mappings[i]->pin] |= (target < 4) ? (mappings[target]->buttonMask << GAMEPAD_LUT_DPAD_SHIFT) : mappings[target]->buttonMask;
+	}
+
+	for (int table = 0; table < GAMEPAD_LUT_COUNT; table++)
+	{
+		for (int value = 0; value < 256; value++)
+		{
+			uint32_t output = 0;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				if (value & (1 << bit))
+					output |= pinOutputs[(table * 8) + bit];
+			}
+			pinLUT[table][value] = output;
+		}
+	}
+}
+
+static double bench(uint32_t (*translate)(uint32_t), const uint32_t *words)
+{
+	volatile uint32_t sink = 0;
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		uint32_t acc = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < BENCH_PASSES; pass++)
+			for (int i = 0; i < BENCH_WORDS; i++)
+				acc ^= translate(words[i]);
+		auto end = std::chrono::steady_clock::now();
+		sink = acc;
+
+		double nanos = std::chrono::duration<double, std::nano>(end - start).count() / ((double)BENCH_PASSES * BENCH_WORDS);
+		if (run == 0 || nanos < best)
+			best = nanos;
+	}
+
+	(void)sink;
+	return best;
+}
+
+int main()
+{
+	uint32_t inputMask = 0;
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		mappings[i] = new Mapping { staticPinMappings[i].pin, 1u << staticPinMappings[i].pin, staticPinMappings[i].buttonMask };
+		inputMask |= mappings[i]->pinMask;
+	}
+	pinLUT = new uint32_t[GAMEPAD_LUT_COUNT][256];
+
+	// Sparse like real play: each button held about one frame in eight
+	static uint32_t words[BENCH_WORDS];
+	srand(2040);
+	for (int i = 0; i < BENCH_WORDS; i++)
+	{
+		words[i] = 0;
+		for (int pin = 0; pin < 32; pin++)
+			words[i] |= ((rand() & 7) == 0) ? (1u << pin) : 0;
+		words[i] &= inputMask;
+	}
+
+	int failures = 0;
+	for (int invert = 0; invert < 2; invert++)
+	{
+		options.invertYAxis = invert;
+		buildTables();
+		for (int i = 0; i < BENCH_WORDS; i++)
+		{
+			uint32_t want = ternaryTranslate(words[i]);
+			if (lutTranslate(words[i]) != want || staticPinsTranslate(words[i]) != want)
+			{
+				printf("MISMATCH invert %d word 0x%08X\n", invert, words[i]);
+				failures++;
+				break;
+			}
+		}
+	}
+	if (failures)
+		return 1;
+
+	options.invertYAxis = false;
+	buildTables();
+	double ternary = bench(ternaryTranslate, words);
+	double lut = bench(lutTranslate, words);
+	double folded = bench(staticPinsTranslate, words);
+	printf("translate, ns per call (best of %d, %d words x %d passes)\n", BENCH_RUNS, BENCH_WORDS, BENCH_PASSES);
+	printf("  ternary     %6.2f\n", ternary);
+	printf("  lut         %6.2f  (%.2fx)\n", lut, ternary / lut);
+	printf("  static pins %6.2f  (%.2fx)\n", folded, ternary / folded);
+	return 0;
+}
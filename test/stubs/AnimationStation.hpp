@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// The LED hotkey values from lib/AnimationStation, without the pico-sdk parts
+
+#ifndef _ANIMATION_STATION_H_
+#define _ANIMATION_STATION_H_
+
+typedef enum
+{
+	HOTKEY_LEDS_NONE,
+	HOTKEY_LEDS_ANIMATION_UP,
+	HOTKEY_LEDS_ANIMATION_DOWN,
+	HOTKEY_LEDS_PARAMETER_UP,
+	HOTKEY_LEDS_PRESS_PARAMETER_UP,
+	HOTKEY_LEDS_PRESS_PARAMETER_DOWN,
+	HOTKEY_LEDS_PARAMETER_DOWN,
+	HOTKEY_LEDS_BRIGHTNESS_UP,
+	HOTKEY_LEDS_BRIGHTNESS_DOWN
+} AnimationHotkey;
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// BoardConfig.h includes this from MPG, the host builds use its pin defines and the enums the hotkey table names
+
+#ifndef _GAMEPAD_ENUMS_H_
+#define _GAMEPAD_ENUMS_H_
+
+typedef enum
+{
+	INPUT_MODE_XINPUT,
+	INPUT_MODE_SWITCH,
+	INPUT_MODE_HID,
+	INPUT_MODE_KEYBOARD,
+	INPUT_MODE_CONFIG = 255,
+} InputMode;
+
+typedef enum
+{
+	DPAD_MODE_DIGITAL,
+	DPAD_MODE_LEFT_ANALOG,
+	DPAD_MODE_RIGHT_ANALOG,
+} DpadMode;
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// Stands in for include/gamepad.h (pico-sdk) in the hotkey test, which only needs the pin mappings
+
+#ifndef _GAMEPAD_H_
+#define _GAMEPAD_H_
+
+#include <stdint.h>
+
+#include "BoardConfig.h"
+#include <MPGS.h>
+
+#include "hotkeys.h"
+
+#define NUM_BANK0_GPIOS 30
+
+struct GamepadButtonMapping
+{
+	GamepadButtonMapping(uint8_t p, uint16_t bm) : pin(p), pinMask((1 << p)), buttonMask(bm) {}
+
+	uint8_t pin;
+	uint32_t pinMask;
+	const uint16_t buttonMask;
+};
+
+#endif
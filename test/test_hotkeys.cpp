@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// HOLD chords against an input loop that, like GP2040::inputsDirty(), only runs the hotkeys when the GPIO
+// word changes or the engine says it's still waiting on one
+
+#include <stdio.h>
+
+#include "gamepad.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void check(bool ok, const char *what, int millis)
+{
+	checks++;
+	if (!ok)
+	{
+		failures++;
+		printf("FAIL: %s at %dms\n", what, millis);
+	}
+}
+
+// Dpad first, then the buttons, one pin each in this order
+static const uint16_t buttonMasks[GAMEPAD_DIGITAL_INPUT_COUNT] = {
+	GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT,
+	GAMEPAD_MASK_B1, GAMEPAD_MASK_B2, GAMEPAD_MASK_B3, GAMEPAD_MASK_B4,
+	GAMEPAD_MASK_L1, GAMEPAD_MASK_R1, GAMEPAD_MASK_L2, GAMEPAD_MASK_R2,
+	GAMEPAD_MASK_S1, GAMEPAD_MASK_S2, GAMEPAD_MASK_L3, GAMEPAD_MASK_R3,
+	GAMEPAD_MASK_A1, GAMEPAD_MASK_A2,
+};
+
+static uint32_t pinFor(uint16_t mask, int first, int last)
+{
+	for (int i = first; i < last; i++)
+	{
+		if (buttonMasks[i] == mask)
+			return 1u << i;
+	}
+	return 0;
+}
+
+static uint32_t buttonPin(uint16_t mask) { return pinFor(mask, 4, GAMEPAD_DIGITAL_INPUT_COUNT); }
+static uint32_t dpadPin(uint8_t mask) { return pinFor(mask, 0, 4); }
+
+// Hold the chord with a still GPIO word for a while, returns the first time (ms) the action fired, or -1
+static int holdChord(HotkeyEngine &engine, uint32_t pins, uint8_t type, uint32_t holdMillis)
+{
+	uint32_t lastPins = 0;
+	int firedAt = -1;
+	HotkeyAction action;
+	for (uint32_t millis = 1; millis <= holdMillis; millis++)
+	{
+		uint32_t now = millis * 1000;
+		if (pins == lastPins && !engine.pending())
+			continue;
+
+		lastPins = pins;
+		engine.process(pins, now);
+		while (engine.pop(action))
+		{
+			if (action.type == type && firedAt < 0)
+				firedAt = millis;
+		}
+	}
+
+	engine.process(0, (holdMillis + 1) * 1000); // Let go
+	while (engine.pop(action)) {}
+	return firedAt;
+}
+
+int main()
+{
+	GamepadButtonMapping *mappings[GAMEPAD_DIGITAL_INPUT_COUNT];
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+		mappings[i] = new GamepadButtonMapping(i, buttonMasks[i]);
+
+	HotkeyEngine engine;
+	engine.compile(mappings);
+
+	uint32_t f1 = buttonPin(GAMEPAD_MASK_S1) | buttonPin(GAMEPAD_MASK_S2);
+
+	// F1 + L3 held 1s: macro record
+	int firedAt = holdChord(engine, f1 | buttonPin(GAMEPAD_MASK_L3), HOTKEY_ACTION_MACRO_RECORD, 1500);
+	check(firedAt == 1001, "macro record hold", firedAt);
+	check(!engine.pending(), "nothing pending after release", 1501);
+
+	// F1 + A1 held 3s: config mode, and not before
+	firedAt = holdChord(engine, f1 | buttonPin(GAMEPAD_MASK_A1), HOTKEY_ACTION_CONFIG_MODE, 2500);
+	check(firedAt < 0, "config mode early", firedAt);
+	firedAt = holdChord(engine, f1 | buttonPin(GAMEPAD_MASK_A1), HOTKEY_ACTION_CONFIG_MODE, 3500);
+	check(firedAt == 3001, "config mode hold", firedAt);
+
+	// Once a HOLD has fired, a still chord is left alone
+	uint32_t pins = f1 | buttonPin(GAMEPAD_MASK_L3);
+	engine.process(pins, 1000);
+	check(engine.pending(), "hold pending", 1);
+	engine.process(pins, 2000000);
+	check(!engine.pending(), "hold fired", 2000);
+	engine.process(0, 2001000);
+	HotkeyAction action;
+	while (engine.pop(action)) {}
+
+	// PRESS chords fire on the change itself and never keep the loop busy
+	engine.process(f1 | dpadPin(GAMEPAD_MASK_DOWN), 1000);
+	check(!engine.pending(), "press not pending", 1);
+	check(engine.pop(action) && action.type == HOTKEY_ACTION_DPAD_MODE, "press fired", 1);
+	engine.process(0, 2000);
+
+	printf("hotkeys: %d checks, %d failures\n", checks, failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// Every value lands in a bin whose range holds it, past the last bin included
+
+#include <stdio.h>
+
+#include "LogBins.h"
+
+int main()
+{
+	// Bin counts in use: switch stats, input latency, profiler
+	const uint8_t binCounts[] = { 52, 64, 96 };
+	int checks = 0;
+	int failures = 0;
+	for (uint8_t bins : binCounts)
+	{
+		uint8_t lastBin = 0;
+		for (uint64_t value = 0; value <= UINT32_MAX; value = value < 4096 ? value + 1 : value + (value >> 9) + 1)
+		{
+			uint8_t bin = logBinFor((uint32_t)value, bins);
+			bool inRange = bin < bins
+				&& bin >= lastBin
+				&& (bin == bins - 1 || value <= logBinUpper(bin))
+				&& (bin == 0 || value > logBinUpper(bin - 1));
+			checks++;
+			if (!inRange)
+			{
+				failures++;
+				printf("FAIL %u bins: %llu in bin %u\n", bins, (unsigned long long)value, bin);
+				break;
+			}
+			lastBin = bin;
+		}
+	}
+
+	// 10 samples at 5, 80 at 100, 10 at 1000
+	uint16_t counts[52] = { };
+	counts[logBinFor(5, 52)] += 10;
+	counts[logBinFor(100, 52)] += 80;
+	counts[logBinFor(1000, 52)] += 10;
+	const struct { uint8_t percent; uint32_t want; } percentiles[] = {
+		{ 10, 5 }, { 50, logBinUpper(logBinFor(100, 52)) }, { 90, logBinUpper(logBinFor(100, 52)) }, { 99, logBinUpper(logBinFor(1000, 52)) },
+	};
+	for (auto &p : percentiles)
+	{
+		uint32_t got = logBinPercentile(counts, 52, 100, p.percent);
+		checks++;
+		if (got != p.want)
+		{
+			failures++;
+			printf("FAIL p%u: got %u, want %u\n", p.percent, got, p.want);
+		}
+	}
+
+	uint16_t empty[52] = { };
+	checks++;
+	if (logBinPercentile(empty, 52, 0, 50) != 0)
+	{
+		failures++;
+		printf("FAIL empty histogram\n");
+	}
+
+	printf("logbins: %d checks, %d failures\n", checks, failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+// Every SOCD mode against every d-pad state and press order, checked against a plain per-mode model
+
+#include <stdio.h>
+
+#include "socd.h"
+
+// Winner of one axis with both directions held, spelled out per mode rather than per axis rule
+static uint8_t expectedAxis(uint8_t mode, bool vertical, uint8_t negative, uint8_t positive, bool positiveLast)
+{
+	uint8_t last = positiveLast ? positive : negative;
+	uint8_t first = positiveLast ? negative : positive;
+	switch (mode)
+	{
+		case SOCD_MODE_UP_PRIORITY:                              return vertical ? negative : 0;
+		case SOCD_MODE_SECOND_INPUT_PRIORITY:                    return last;
+		case SOCD_MODE_FIRST_INPUT_PRIORITY:                     return first;
+		case SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL:      return vertical ? negative : last;
+		case SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL: return vertical ? last : 0;
+		default:                                                 return 0; // Neutral, and unknown modes
+	}
+}
+
+static uint8_t expected(uint8_t mode, uint8_t dpad, bool downLast, bool rightLast)
+{
+	uint8_t result = dpad & ~(GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+	uint8_t vertical = dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN);
+	uint8_t horizontal = dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+
+	if (vertical == (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+		vertical = expectedAxis(mode, true, GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, downLast);
+	if (horizontal == (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+		horizontal = expectedAxis(mode, false, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT, rightLast);
+
+	return result | vertical | horizontal;
+}
+
+int main()
+{
+	// Press times for each order, including a pair across the time_us_32() wrap
+	const uint32_t earlier[] = { 1000, 0xFFFFFFF0 };
+	const uint32_t later[]   = { 2000, 0x00000010 };
+	const uint8_t modes[] = {
+		SOCD_MODE_UP_PRIORITY,
+		SOCD_MODE_NEUTRAL,
+		SOCD_MODE_SECOND_INPUT_PRIORITY,
+		SOCD_MODE_FIRST_INPUT_PRIORITY,
+		SOCD_MODE_UP_PRIORITY_SECOND_INPUT_HORIZONTAL,
+		SOCD_MODE_SECOND_INPUT_VERTICAL_NEUTRAL_HORIZONTAL,
+		SOCD_MODE_COUNT, // Unknown, falls back to neutral
+		0xFF,
+	};
+
+	SOCDCleaner cleaner;
+	int checks = 0;
+	int failures = 0;
+	for (uint8_t mode : modes)
+	{
+		cleaner.setMode(mode);
+		for (uint8_t dpad = 0; dpad < 16; dpad++)
+		{
+			for (int order = 0; order < 4; order++)
+			{
+				bool downLast = order & 1;
+				bool rightLast = order & 2;
+				for (int clock = 0; clock < 2; clock++)
+				{
+					uint32_t pressMicros[4] = {
+						downLast ? earlier[clock] : later[clock],  // Up
+						downLast ? later[clock] : earlier[clock],  // Down
+						rightLast ? earlier[clock] : later[clock], // Left
+						rightLast ? later[clock] : earlier[clock], // Right
+					};
+
+					uint8_t want = expected(mode, dpad, downLast, rightLast);
+					uint8_t got = cleaner.process(dpad, pressMicros);
+					checks++;
+					if (got != want)
+					{
+						failures++;
+						printf("FAIL mode %u dpad 0x%X %s last, %s last, clock %d: got 0x%X, want 0x%X\n",
+							mode, dpad, downLast ? "down" : "up", rightLast ? "right" : "left", clock, got, want);
+					}
+				}
+			}
+
+			// Pressed at the same time, Up and Left count as last
+			uint32_t same[4] = { 500, 500, 500, 500 };
+			uint8_t want = expected(mode, dpad, false, false);
+			uint8_t got = cleaner.process(dpad, same);
+			checks++;
+			if (got != want)
+			{
+				failures++;
+				printf("FAIL mode %u dpad 0x%X same time: got 0x%X, want 0x%X\n", mode, dpad, got, want);
+			}
+		}
+
+		if (cleaner.getMode() != mode)
+		{
+			failures++;
+			printf("FAIL mode %u reads back as %u\n", mode, cleaner.getMode());
+		}
+	}
+
+	printf("socd: %d checks, %d failures\n", checks, failures);
+	return failures ? 1 : 0;
+}
@@ -58,6 +58,7 @@ app.get('/api/getGamepadOptions', (req, res) => {
 		dpadMode: 0,
 		inputMode: 1,
 		socdMode: 2,
+		pollInterval: 0,
 	});
 });
 
@@ -126,6 +127,145 @@ app.get('/api/getAddonsOptions', (req, res) => {
 	});
 });
 
+app.get('/api/getPerfStats', (req, res) => {
+	console.log('/api/getPerfStats');
+	return res.send({
+		enabled: true,
+		cyclesPerMicro: 125,
+		stages: [
+			{ name: 'read', count: 120000, min: 1.2, avg: 1.4, max: 3.1, p99: 1.8 },
+			{ name: 'debounce', count: 120000, min: 0.6, avg: 0.7, max: 1.9, p99: 1.0 },
+			{ name: 'hotkey', count: 120000, min: 0.3, avg: 0.4, max: 0.9, p99: 0.5 },
+			{ name: 'process', count: 120000, min: 0.8, avg: 1.1, max: 2.6, p99: 1.5 },
+			{ name: 'memcpy', count: 120000, min: 0.1, avg: 0.1, max: 0.3, p99: 0.2 },
+			{ name: 'send_report', count: 120000, min: 0.9, avg: 2.3, max: 8.4, p99: 5.1 },
+			{ name: 'receive_report', count: 120000, min: 0.2, avg: 0.3, max: 1.2, p99: 0.5 },
+			{ name: 'tud_task', count: 120000, min: 0.7, avg: 4.2, max: 41.0, p99: 19.5 },
+			{ name: 'TURBO', count: 120000, min: 0.3, avg: 0.4, max: 0.8, p99: 0.5 },
+		],
+	});
+});
+
+app.get('/api/getBootStats', (req, res) => {
+	console.log('/api/getBootStats');
+	return res.send({
+		fastBoot: false,
+		stages: {
+			main: 2410,
+			storage: 2985,
+			gamepad: 3120,
+			usbInit: 3390,
+			inputs: 3455,
+			usbMounted: 182400,
+			firstReport: 183100,
+			auxStart: 3470,
+			auxReady: 24950,
+		},
+		addons: [
+			{ name: 'TURBO', core: 0, micros: 42 },
+			{ name: 'I2CDisplay', core: 1, micros: 1210 },
+			{ name: 'NeoPicoLED', core: 1, micros: 20180 },
+		],
+	});
+});
+
+app.get('/api/getDebounceOptions', (req, res) => {
+	console.log('/api/getDebounceOptions');
+	return res.send({
+		mode: 1,
+		windows: {
+			Up: 5000, Down: 5000, Left: 5000, Right: 5000,
+			B1: 5000, B2: 5000, B3: 5000, B4: 5000,
+			L1: 5000, R1: 5000, L2: 5000, R2: 5000,
+			S1: 5000, S2: 5000, L3: 5000, R3: 5000,
+			A1: 5000, A2: 5000,
+		},
+	});
+});
+
+app.get('/api/getRemapOptions', (req, res) => {
+	console.log('/api/getRemapOptions');
+	const identity = {
+		Up: 'Up', Down: 'Down', Left: 'Left', Right: 'Right',
+		B1: 'B1', B2: 'B2', B3: 'B3', B4: 'B4',
+		L1: 'L1', R1: 'R1', L2: 'L2', R2: 'R2',
+		S1: 'S1', S2: 'S2', L3: 'L3', R3: 'R3',
+		A1: 'A1', A2: 'A2',
+	};
+	return res.send({
+		profile: 0,
+		profiles: [
+			identity,
+			{ ...identity, B3: 'B4', B4: 'B3' },
+			{ ...identity, L1: 'R2', R2: 'L1' },
+			{ ...identity, A2: null },
+		],
+	});
+});
+
+app.get('/api/getSchedulerStats', (req, res) => {
+	console.log('/api/getSchedulerStats');
+	return res.send({
+		tasks: [
+			{ name: 'I2CDisplay', period: 20000, priority: 2, budget: 15000, runs: 2960, avg: 1840, max: 11210, misses: 0, overruns: 0 },
+			{ name: 'NeoPicoLED', period: 10000, priority: 0, budget: 4000, runs: 5921, avg: 2210, max: 3350, misses: 2, overruns: 0 },
+			{ name: 'PLED', period: 1000, priority: 1, budget: 500, runs: 59180, avg: 12, max: 40, misses: 31, overruns: 0 },
+		],
+	});
+});
+
+app.get('/api/getLatencyStats', (req, res) => {
+	console.log('/api/getLatencyStats');
+	return res.send({
+		modes: [
+			{ name: 'xinput', count: 4812, p50: 767, p99: 1535, max: 1893 },
+			{ name: 'switch', count: 0, p50: 0, p99: 0, max: 0 },
+			{ name: 'hid', count: 1290, p50: 895, p99: 1791, max: 2104 },
+		],
+	});
+});
+
+app.get('/api/getSwitchStats', (req, res) => {
+	console.log('/api/getSwitchStats');
+	return res.send({
+		bounceWindow: 10000,
+		buttons: [
+			{ name: 'Up', pin: 2, actuations: 18211, bounces: 412, chatters: 3, p50: 447, p99: 1279, max: 1390, window: 5000, suggested: 1800 },
+			{ name: 'Down', pin: 3, actuations: 16930, bounces: 388, chatters: 0, p50: 383, p99: 1151, max: 1204, window: 5000, suggested: 1600 },
+			{ name: 'Left', pin: 4, actuations: 20544, bounces: 501, chatters: 1, p50: 415, p99: 1215, max: 1302, window: 5000, suggested: 1700 },
+			{ name: 'Right', pin: 5, actuations: 21087, bounces: 6932, chatters: 41, p50: 1791, p99: 4095, max: 4410, window: 5000, suggested: 5600 },
+			{ name: 'B1', pin: 6, actuations: 9120, bounces: 0, chatters: 0, p50: 0, p99: 0, max: 0, window: 5000, suggested: 0 },
+			{ name: 'B2', pin: 7, actuations: 7433, bounces: 12, chatters: 0, p50: 191, p99: 319, max: 301, window: 5000, suggested: 400 },
+		],
+	});
+});
+
+app.get('/api/getInputTrace', (req, res) => {
+	console.log('/api/getInputTrace');
+	const states = [
+		{ micros: 1000250, gpio: 0x00000000, buttons: 0x0000, dpad: 0x00 },
+		{ micros: 1016248, gpio: 0x00000004, buttons: 0x0001, dpad: 0x00 },
+		{ micros: 1033251, gpio: 0x00000005, buttons: 0x0001, dpad: 0x02 },
+		{ micros: 1049249, gpio: 0x00000000, buttons: 0x0000, dpad: 0x00 },
+	];
+	const data = Buffer.alloc(16 + states.length * 24);
+	data.writeUInt32LE(0x52545047, 0);
+	data.writeUInt16LE(1, 4);
+	data.writeUInt16LE(24, 6);
+	data.writeUInt32LE(states.length, 8);
+	data.writeUInt32LE(states.length, 12);
+	states.forEach((state, i) => {
+		const offset = 16 + i * 24;
+		data.writeUInt32LE(state.micros, offset);
+		data.writeUInt32LE(state.gpio, offset + 4);
+		data.writeUInt16LE(state.buttons, offset + 8);
+		[0, 32767, 32767, 32767, 32767].forEach((value, axis) => data.writeUInt16LE(value, offset + 10 + axis * 2));
+		data.writeUInt8(state.dpad, offset + 20);
+	});
+	res.set('Content-Type', 'application/octet-stream');
+	return res.send(data);
+});
+
 app.post('/api/*', (req, res) => {
 	console.log(req.url);
 	return res.send(req.body);
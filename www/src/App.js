@@ -10,6 +10,7 @@ import SettingsPage from './Pages/SettingsPage';
 import DisplayConfigPage from './Pages/DisplayConfig';
 import LEDConfigPage from './Pages/LEDConfigPage';
 import AddonsConfigPage from './Pages/AddonsConfigPage';
+import SwitchStatsPage from './Pages/SwitchStatsPage';
 
 import { loadButtonLabels } from './Services/Storage';
 import './App.scss';
@@ -49,6 +50,9 @@ const App = () => {
 						<Route path="/add-ons">
 							<AddonsConfigPage />
 						</Route>
+						<Route path="/switch-stats">
+							<SwitchStatsPage />
+						</Route>
 					</Switch>
 				</div>
 			</Router>
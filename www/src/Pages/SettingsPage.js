@@ -21,12 +21,24 @@ const SOCD_MODES = [
 	{ label: 'Up Priority', value: 0 },
 	{ label: 'Neutral', value: 1 },
 	{ label: 'Last Win', value: 2 },
+	{ label: 'First Win', value: 3 },
+	{ label: 'Up Priority, Last Win Horizontal', value: 4 },
+	{ label: 'Last Win Vertical, Neutral Horizontal', value: 5 },
+];
+
+const POLL_INTERVALS = [
+	{ label: 'Default', value: 0 },
+	{ label: '1000 Hz (1 ms)', value: 1 },
+	{ label: '500 Hz (2 ms)', value: 2 },
+	{ label: '250 Hz (4 ms)', value: 4 },
+	{ label: '125 Hz (8 ms)', value: 8 },
 ];
 
 const schema = yup.object().shape({
 	dpadMode : yup.number().required().oneOf(DPAD_MODES.map(o => o.value)).label('D-Pad Mode'),
 	inputMode: yup.number().required().oneOf(INPUT_MODES.map(o => o.value)).label('Input Mode'),
 	socdMode : yup.number().required().oneOf(SOCD_MODES.map(o => o.value)).label('SOCD Mode'),
+	pollInterval: yup.number().required().oneOf(POLL_INTERVALS.map(o => o.value)).label('Poll Rate'),
 });
 
 const FormContext = () => {
@@ -46,6 +58,8 @@ const FormContext = () => {
 			values.inputMode = parseInt(values.inputMode);
 		if (!!values.socdMode)
 			values.socdMode = parseInt(values.socdMode);
+		if (!!values.pollInterval)
+			values.pollInterval = parseInt(values.pollInterval);
 	}, [values, setValues]);
 
 	return null;
@@ -98,6 +112,15 @@ export default function SettingsPage() {
 								<Form.Control.Feedback type="invalid">{errors.socdMode}</Form.Control.Feedback>
 							</div>
 						</Form.Group>
+						<Form.Group className="row mb-3">
+							<Form.Label>Poll Rate</Form.Label>
+							<div className="col-sm-3">
+								<Form.Select name="pollInterval" className="form-select-sm" value={values.pollInterval} onChange={handleChange} isInvalid={errors.pollInterval}>
+									{POLL_INTERVALS.map((o, i) => <option key={`button-pollInterval-option-${i}`} value={o.value}>{o.label}</option>)}
+								</Form.Select>
+								<Form.Control.Feedback type="invalid">{errors.pollInterval}</Form.Control.Feedback>
+							</div>
+						</Form.Group>
 						<Button type="submit">Save</Button>
 						{saveMessage ? <span className="alert">{saveMessage}</span> : null}
 						<FormContext />
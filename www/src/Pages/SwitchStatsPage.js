@@ -0,0 +1,61 @@
+import React, { useContext, useEffect, useState } from 'react';
+import { AppContext } from '../Contexts/AppContext';
+import Section from '../Components/Section';
+import WebApi from '../Services/WebApi';
+import BUTTONS from '../Data/Buttons.json';
+
+export default function SwitchStatsPage() {
+	const { buttonLabels } = useContext(AppContext);
+	const [switchStats, setSwitchStats] = useState({ bounceWindow: 0, buttons: [] });
+
+	useEffect(() => {
+		async function fetchData() {
+			const stats = await WebApi.getSwitchStats();
+			if (stats)
+				setSwitchStats(stats);
+		}
+
+		fetchData();
+	}, [setSwitchStats]);
+
+	return (
+		<Section title="Switch Health">
+			<p>
+				Actuation, bounce and chatter counts for each switch. Counts are kept for the life of the controller, bounce
+				times since it was last powered on. Raw edges less than {switchStats.bounceWindow}&micro;s apart count as one bounce.
+			</p>
+			<p>
+				Chatter is a pulse that comes and goes without the button being pressed, usually a worn switch or a loose wire.
+				A switch that bounces longer than its debounce window can register extra presses.
+			</p>
+			<table className="table table-sm">
+				<thead className="table">
+					<tr>
+						<th>{BUTTONS[buttonLabels].label}</th>
+						<th>Pin</th>
+						<th>Actuations</th>
+						<th>Bounces</th>
+						<th>Chatter</th>
+						<th>Bounce p50 / p99 / max (&micro;s)</th>
+						<th>Debounce Window (&micro;s)</th>
+						<th>Suggested (&micro;s)</th>
+					</tr>
+				</thead>
+				<tbody>
+					{switchStats.buttons.map((button, i) =>
+						<tr key={`switch-stats-${i}`} className={button.suggested > button.window ? "table-warning" : ""}>
+							<td>{BUTTONS[buttonLabels][button.name]}</td>
+							<td>{button.pin}</td>
+							<td>{button.actuations}</td>
+							<td>{button.bounces}</td>
+							<td>{button.chatters}</td>
+							<td>{button.p50} / {button.p99} / {button.max}</td>
+							<td>{button.window}</td>
+							<td>{button.suggested || '-'}</td>
+						</tr>
+					)}
+				</tbody>
+			</table>
+		</Section>
+	);
+}
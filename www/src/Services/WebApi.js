@@ -64,7 +64,7 @@ async function setGamepadOptions(options) {
 	return axios.post(`${baseUrl}/api/setGamepadOptions`, options)
 		.then((response) => {
 			console.log(response.data);
-			return true;
+			return !response.data.error;
 		})
 		.catch((err) => {
 			console.error(err);
@@ -135,6 +135,78 @@ async function setAddonsOptions(options) {
 		});
 }
 
+async function getDebounceOptions() {
+	return axios.get(`${baseUrl}/api/getDebounceOptions`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function setDebounceOptions(options) {
+	return axios.post(`${baseUrl}/api/setDebounceOptions`, options)
+		.then((response) => {
+			console.log(response.data);
+			return !response.data.error;
+		})
+		.catch((err) => {
+			console.error(err);
+			return false;
+		});
+}
+
+async function getRemapOptions() {
+	return axios.get(`${baseUrl}/api/getRemapOptions`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function setRemapOptions(options) {
+	return axios.post(`${baseUrl}/api/setRemapOptions`, options)
+		.then((response) => {
+			console.log(response.data);
+			return true;
+		})
+		.catch((err) => {
+			console.error(err);
+			return false;
+		});
+}
+
+async function getPerfStats() {
+	return axios.get(`${baseUrl}/api/getPerfStats`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getBootStats() {
+	return axios.get(`${baseUrl}/api/getBootStats`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getSchedulerStats() {
+	return axios.get(`${baseUrl}/api/getSchedulerStats`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getLatencyStats() {
+	return axios.get(`${baseUrl}/api/getLatencyStats`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getSwitchStats() {
+	return axios.get(`${baseUrl}/api/getSwitchStats`)
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getInputTrace() {
+	return axios.get(`${baseUrl}/api/getInputTrace`, { responseType: 'arraybuffer' })
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
 const WebApi = {
 	resetSettings,
 	getDisplayOptions,
@@ -146,7 +218,17 @@ const WebApi = {
 	getPinMappings,
 	setPinMappings,
 	getAddonsOptions,
-	setAddonsOptions
+	setAddonsOptions,
+	getDebounceOptions,
+	setDebounceOptions,
+	getRemapOptions,
+	setRemapOptions,
+	getPerfStats,
+	getBootStats,
+	getSchedulerStats,
+	getLatencyStats,
+	getSwitchStats,
+	getInputTrace
 };
 
 export default WebApi;